@@ -0,0 +1,829 @@
+#ifndef AGGRO_ALGORITHM_HPP
+#define AGGRO_ALGORITHM_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include "optional.hpp"
+#include "concepts/objects.hpp"
+
+//Define AGGRO_NO_SIMD to build the plain loops only, as on targets other than x86.
+#if !defined(AGGRO_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+    #define AGGRO_SIMD_X86 1
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define AGGRO_SIMD_TARGET(isa)
+        #define AGGRO_SIMD_INLINE __forceinline
+    #else
+        #include <cpuid.h>
+        #define AGGRO_SIMD_TARGET(isa) __attribute__((target(isa)))
+        #define AGGRO_SIMD_INLINE inline __attribute__((always_inline))
+    #endif
+#else
+    #define AGGRO_SIMD_X86 0
+    #define AGGRO_SIMD_INLINE inline
+#endif
+
+//The kernels pass vector registers around in functions not compiled for that ISA, which GCC warns about;
+//they are always inlined into one that is. GCC 12 also flags the undefined source of some AVX-512 intrinsics.
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpsabi"
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace aggro
+{
+    //Instruction sets the search and reduction kernels can run on, from least to most capable.
+    enum class simd_level : std::uint8_t
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    //Element types that have vector kernels. Every other arithmetic type runs the scalar loop.
+    template<typename T>
+    concept simd_lane = same<T, float> || same<T, double> ||
+        (std::is_integral_v<T> && !same<T, bool> && (sizeof(T) == 4u || sizeof(T) == 8u));
+
+    template<typename T>
+    concept arithmetic = std::is_arithmetic_v<T>;
+
+    namespace simd_detail
+    {
+        //Best level this CPU and OS support, read once through CPUID.
+        inline simd_level detect()
+        {
+#if AGGRO_SIMD_X86
+            unsigned int regs[4] = {};  //eax, ebx, ecx, edx
+
+            auto cpuid = [&regs](unsigned int leaf)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                int out[4];
+                __cpuidex(out, static_cast<int>(leaf), 0);
+                for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned int>(out[i]);
+#else
+                __cpuid_count(leaf, 0u, regs[0], regs[1], regs[2], regs[3]);
+#endif
+            };
+
+            cpuid(0u);
+            const unsigned int max_leaf = regs[0];
+
+            cpuid(1u);
+            if ((regs[3] & (1u << 26)) == 0u) return simd_level::scalar;
+
+            //AVX state must be enabled by the OS (OSXSAVE, then XCR0 bits for XMM and YMM).
+            if ((regs[2] & (1u << 27)) == 0u || (regs[2] & (1u << 28)) == 0u || max_leaf < 7u)
+                return simd_level::sse2;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+            const std::uint64_t xcr0 = _xgetbv(0);
+#else
+            unsigned int lo = 0u, hi = 0u;
+            __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0u));
+            const std::uint64_t xcr0 = (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+
+            if ((xcr0 & 0x6u) != 0x6u) return simd_level::sse2;
+
+            cpuid(7u);
+            if ((regs[1] & (1u << 5)) == 0u) return simd_level::sse2;
+
+            //AVX-512F also needs the opmask and ZMM state enabled.
+            if ((regs[1] & (1u << 16)) != 0u && (xcr0 & 0xE6u) == 0xE6u) return simd_level::avx512;
+
+            return simd_level::avx2;
+#else
+            return simd_level::scalar;
+#endif
+        }
+
+        struct levels
+        {
+            simd_level supported = detect();
+            std::atomic<simd_level> active { supported };
+        };
+
+        inline levels& state()
+        {
+            static levels instance;
+            return instance;
+        }
+
+    } // namespace simd_detail
+
+    //Best instruction set this machine supports.
+    inline simd_level simd_supported() { return simd_detail::state().supported; }
+
+    //Instruction set the kernels currently dispatch to.
+    inline simd_level simd_active() { return simd_detail::state().active.load(std::memory_order_relaxed); }
+
+    //Caps the instruction set the kernels use, for testing and benchmarking each path. Levels above what the
+    //machine supports are clamped to it.
+    inline void simd_limit(simd_level level)
+    {
+        simd_detail::levels& s = simd_detail::state();
+        s.active.store(level < s.supported ? level : s.supported, std::memory_order_relaxed);
+    }
+
+    constexpr const char* simd_level_name(simd_level level)
+    {
+        switch (level)
+        {
+        case simd_level::sse2: return "sse2";
+        case simd_level::avx2: return "avx2";
+        case simd_level::avx512: return "avx512";
+        default: return "scalar";
+        }
+    }
+
+    namespace simd_detail
+    {
+#if AGGRO_SIMD_X86
+        #define AGGRO_SSE2_OP static inline AGGRO_SIMD_TARGET("sse2")
+        #define AGGRO_AVX2_OP static inline AGGRO_SIMD_TARGET("avx2")
+        #define AGGRO_AVX512_OP static inline AGGRO_SIMD_TARGET("avx512f")
+
+        template<typename T>
+        concept lane32 = std::is_integral_v<T> && sizeof(T) == 4u;
+
+        template<typename T>
+        concept lane64 = std::is_integral_v<T> && sizeof(T) == 8u;
+
+        /*
+            One struct per instruction set and lane type, wrapping the intrinsics the kernels need: load, store,
+            set1, zero, add, min, max and eq, which returns one mask bit per lane. has_minmax is false where the
+            instruction set has no usable compare for the type.
+        */
+        template<typename T>
+        struct sse2_ops;
+
+        template<>
+        struct sse2_ops<float>
+        {
+            using reg = __m128;
+            static constexpr std::size_t lanes = 4u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_SSE2_OP reg load(const float* p) { return _mm_loadu_ps(p); }
+            AGGRO_SSE2_OP void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+            AGGRO_SSE2_OP reg set1(float v) { return _mm_set1_ps(v); }
+            AGGRO_SSE2_OP reg zero() { return _mm_setzero_ps(); }
+            AGGRO_SSE2_OP reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+            AGGRO_SSE2_OP reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+            AGGRO_SSE2_OP reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+            AGGRO_SSE2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+        };
+
+        template<>
+        struct sse2_ops<double>
+        {
+            using reg = __m128d;
+            static constexpr std::size_t lanes = 2u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_SSE2_OP reg load(const double* p) { return _mm_loadu_pd(p); }
+            AGGRO_SSE2_OP void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+            AGGRO_SSE2_OP reg set1(double v) { return _mm_set1_pd(v); }
+            AGGRO_SSE2_OP reg zero() { return _mm_setzero_pd(); }
+            AGGRO_SSE2_OP reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+            AGGRO_SSE2_OP reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+            AGGRO_SSE2_OP reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+            AGGRO_SSE2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+        };
+
+        //SSE2 has no 32-bit min or max, so they are built from a signed compare. Unsigned lanes are biased first.
+        template<lane32 T>
+        struct sse2_ops<T>
+        {
+            using reg = __m128i;
+            static constexpr std::size_t lanes = 4u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_SSE2_OP reg load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            AGGRO_SSE2_OP void store(T* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            AGGRO_SSE2_OP reg set1(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+            AGGRO_SSE2_OP reg zero() { return _mm_setzero_si128(); }
+            AGGRO_SSE2_OP reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+            AGGRO_SSE2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+
+            AGGRO_SSE2_OP reg greater(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>)
+                {
+                    return _mm_cmpgt_epi32(a, b);
+                }
+                else
+                {
+                    const reg bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+                    return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+                }
+            }
+
+            AGGRO_SSE2_OP reg min(reg a, reg b)
+            {
+                const reg gt = greater(a, b);
+                return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+            }
+
+            AGGRO_SSE2_OP reg max(reg a, reg b)
+            {
+                const reg gt = greater(a, b);
+                return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+            }
+        };
+
+        //SSE2 has no 64-bit compare at all. Equality is pieced together from the 32-bit halves.
+        template<lane64 T>
+        struct sse2_ops<T>
+        {
+            using reg = __m128i;
+            static constexpr std::size_t lanes = 2u;
+            static constexpr bool has_minmax = false;
+
+            AGGRO_SSE2_OP reg load(const T* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            AGGRO_SSE2_OP void store(T* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+            AGGRO_SSE2_OP reg set1(T v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+            AGGRO_SSE2_OP reg zero() { return _mm_setzero_si128(); }
+            AGGRO_SSE2_OP reg add(reg a, reg b) { return _mm_add_epi64(a, b); }
+
+            AGGRO_SSE2_OP std::uint32_t eq(reg a, reg b)
+            {
+                const reg halves = _mm_cmpeq_epi32(a, b);
+                const reg both = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(both)));
+            }
+        };
+
+        template<typename T>
+        struct avx2_ops;
+
+        template<>
+        struct avx2_ops<float>
+        {
+            using reg = __m256;
+            static constexpr std::size_t lanes = 8u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX2_OP reg load(const float* p) { return _mm256_loadu_ps(p); }
+            AGGRO_AVX2_OP void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+            AGGRO_AVX2_OP reg set1(float v) { return _mm256_set1_ps(v); }
+            AGGRO_AVX2_OP reg zero() { return _mm256_setzero_ps(); }
+            AGGRO_AVX2_OP reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+            AGGRO_AVX2_OP reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+            AGGRO_AVX2_OP reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+            AGGRO_AVX2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+        };
+
+        template<>
+        struct avx2_ops<double>
+        {
+            using reg = __m256d;
+            static constexpr std::size_t lanes = 4u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX2_OP reg load(const double* p) { return _mm256_loadu_pd(p); }
+            AGGRO_AVX2_OP void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+            AGGRO_AVX2_OP reg set1(double v) { return _mm256_set1_pd(v); }
+            AGGRO_AVX2_OP reg zero() { return _mm256_setzero_pd(); }
+            AGGRO_AVX2_OP reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+            AGGRO_AVX2_OP reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+            AGGRO_AVX2_OP reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+            AGGRO_AVX2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+        };
+
+        template<lane32 T>
+        struct avx2_ops<T>
+        {
+            using reg = __m256i;
+            static constexpr std::size_t lanes = 8u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX2_OP reg load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            AGGRO_AVX2_OP void store(T* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            AGGRO_AVX2_OP reg set1(T v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+            AGGRO_AVX2_OP reg zero() { return _mm256_setzero_si256(); }
+            AGGRO_AVX2_OP reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+            AGGRO_AVX2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+
+            AGGRO_AVX2_OP reg min(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm256_min_epi32(a, b);
+                else return _mm256_min_epu32(a, b);
+            }
+
+            AGGRO_AVX2_OP reg max(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm256_max_epi32(a, b);
+                else return _mm256_max_epu32(a, b);
+            }
+        };
+
+        //AVX2 has a 64-bit signed compare but no 64-bit min or max, so they are blends on that compare.
+        template<lane64 T>
+        struct avx2_ops<T>
+        {
+            using reg = __m256i;
+            static constexpr std::size_t lanes = 4u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX2_OP reg load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+            AGGRO_AVX2_OP void store(T* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+            AGGRO_AVX2_OP reg set1(T v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+            AGGRO_AVX2_OP reg zero() { return _mm256_setzero_si256(); }
+            AGGRO_AVX2_OP reg add(reg a, reg b) { return _mm256_add_epi64(a, b); }
+            AGGRO_AVX2_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+
+            AGGRO_AVX2_OP reg greater(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>)
+                {
+                    return _mm256_cmpgt_epi64(a, b);
+                }
+                else
+                {
+                    const reg bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+                    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+                }
+            }
+
+            AGGRO_AVX2_OP reg min(reg a, reg b) { return _mm256_blendv_epi8(a, b, greater(a, b)); }
+            AGGRO_AVX2_OP reg max(reg a, reg b) { return _mm256_blendv_epi8(b, a, greater(a, b)); }
+        };
+
+        template<typename T>
+        struct avx512_ops;
+
+        template<>
+        struct avx512_ops<float>
+        {
+            using reg = __m512;
+            static constexpr std::size_t lanes = 16u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX512_OP reg load(const float* p) { return _mm512_loadu_ps(p); }
+            AGGRO_AVX512_OP void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+            AGGRO_AVX512_OP reg set1(float v) { return _mm512_set1_ps(v); }
+            AGGRO_AVX512_OP reg zero() { return _mm512_setzero_ps(); }
+            AGGRO_AVX512_OP reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+            AGGRO_AVX512_OP reg min(reg a, reg b) { return _mm512_min_ps(a, b); }
+            AGGRO_AVX512_OP reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+            AGGRO_AVX512_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ)); }
+        };
+
+        template<>
+        struct avx512_ops<double>
+        {
+            using reg = __m512d;
+            static constexpr std::size_t lanes = 8u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX512_OP reg load(const double* p) { return _mm512_loadu_pd(p); }
+            AGGRO_AVX512_OP void store(double* p, reg v) { _mm512_storeu_pd(p, v); }
+            AGGRO_AVX512_OP reg set1(double v) { return _mm512_set1_pd(v); }
+            AGGRO_AVX512_OP reg zero() { return _mm512_setzero_pd(); }
+            AGGRO_AVX512_OP reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+            AGGRO_AVX512_OP reg min(reg a, reg b) { return _mm512_min_pd(a, b); }
+            AGGRO_AVX512_OP reg max(reg a, reg b) { return _mm512_max_pd(a, b); }
+            AGGRO_AVX512_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ)); }
+        };
+
+        template<lane32 T>
+        struct avx512_ops<T>
+        {
+            using reg = __m512i;
+            static constexpr std::size_t lanes = 16u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX512_OP reg load(const T* p) { return _mm512_loadu_si512(p); }
+            AGGRO_AVX512_OP void store(T* p, reg v) { _mm512_storeu_si512(p, v); }
+            AGGRO_AVX512_OP reg set1(T v) { return _mm512_set1_epi32(static_cast<int>(v)); }
+            AGGRO_AVX512_OP reg zero() { return _mm512_setzero_si512(); }
+            AGGRO_AVX512_OP reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+            AGGRO_AVX512_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm512_cmpeq_epi32_mask(a, b)); }
+
+            AGGRO_AVX512_OP reg min(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm512_min_epi32(a, b);
+                else return _mm512_min_epu32(a, b);
+            }
+
+            AGGRO_AVX512_OP reg max(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm512_max_epi32(a, b);
+                else return _mm512_max_epu32(a, b);
+            }
+        };
+
+        template<lane64 T>
+        struct avx512_ops<T>
+        {
+            using reg = __m512i;
+            static constexpr std::size_t lanes = 8u;
+            static constexpr bool has_minmax = true;
+
+            AGGRO_AVX512_OP reg load(const T* p) { return _mm512_loadu_si512(p); }
+            AGGRO_AVX512_OP void store(T* p, reg v) { _mm512_storeu_si512(p, v); }
+            AGGRO_AVX512_OP reg set1(T v) { return _mm512_set1_epi64(static_cast<long long>(v)); }
+            AGGRO_AVX512_OP reg zero() { return _mm512_setzero_si512(); }
+            AGGRO_AVX512_OP reg add(reg a, reg b) { return _mm512_add_epi64(a, b); }
+            AGGRO_AVX512_OP std::uint32_t eq(reg a, reg b) { return static_cast<std::uint32_t>(_mm512_cmpeq_epi64_mask(a, b)); }
+
+            AGGRO_AVX512_OP reg min(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm512_min_epi64(a, b);
+                else return _mm512_min_epu64(a, b);
+            }
+
+            AGGRO_AVX512_OP reg max(reg a, reg b)
+            {
+                if constexpr (std::is_signed_v<T>) return _mm512_max_epi64(a, b);
+                else return _mm512_max_epu64(a, b);
+            }
+        };
+
+        #undef AGGRO_SSE2_OP
+        #undef AGGRO_AVX2_OP
+        #undef AGGRO_AVX512_OP
+#endif // AGGRO_SIMD_X86
+
+        //Integer sums wrap instead of overflowing, the same on every path.
+        template<typename T>
+        struct sum_type_of { using type = T; };
+
+        template<typename T> requires (std::is_integral_v<T> && !same<T, bool>)
+        struct sum_type_of<T> { using type = std::make_unsigned_t<T>; };
+
+        template<typename T>
+        using sum_type = typename sum_type_of<T>::type;
+
+        /*
+            Each kernel has a scalar version and a vector one written against the ops structs above. The vector
+            version is instantiated inside a function compiled for its instruction set, which it is inlined into.
+        */
+        struct find_kernel
+        {
+            template<typename T>
+            static std::size_t scalar(const T* data, std::size_t count, T value)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    if (data[i] == value) return i;
+
+                return count;
+            }
+
+            template<typename V, typename T>
+            static AGGRO_SIMD_INLINE std::size_t run(const T* data, std::size_t count, T value)
+            {
+                const auto needle = V::set1(value);
+                std::size_t i = 0;
+
+                for (; i + V::lanes <= count; i += V::lanes)
+                {
+                    const std::uint32_t mask = V::eq(V::load(data + i), needle);
+                    if (mask != 0u) return i + static_cast<std::size_t>(std::countr_zero(mask));
+                }
+
+                for (; i < count; i++)
+                    if (data[i] == value) return i;
+
+                return count;
+            }
+        };
+
+        struct count_kernel
+        {
+            template<typename T>
+            static std::size_t scalar(const T* data, std::size_t count, T value)
+            {
+                std::size_t found = 0u;
+
+                for (std::size_t i = 0; i < count; i++)
+                    found += (data[i] == value) ? 1u : 0u;
+
+                return found;
+            }
+
+            template<typename V, typename T>
+            static AGGRO_SIMD_INLINE std::size_t run(const T* data, std::size_t count, T value)
+            {
+                const auto needle = V::set1(value);
+                std::size_t found = 0u;
+                std::size_t i = 0;
+
+                for (; i + V::lanes <= count; i += V::lanes)
+                    found += static_cast<std::size_t>(std::popcount(V::eq(V::load(data + i), needle)));
+
+                for (; i < count; i++)
+                    found += (data[i] == value) ? 1u : 0u;
+
+                return found;
+            }
+        };
+
+        struct sum_kernel
+        {
+            template<typename T>
+            static T scalar(const T* data, std::size_t count)
+            {
+                sum_type<T> total {};
+
+                for (std::size_t i = 0; i < count; i++)
+                    total += static_cast<sum_type<T>>(data[i]);
+
+                return static_cast<T>(total);
+            }
+
+            //Four accumulators keep four adds in flight. Floating point sums are added in a different order
+            //than the scalar loop, so they can differ from it by rounding.
+            template<typename V, typename T>
+            static AGGRO_SIMD_INLINE T run(const T* data, std::size_t count)
+            {
+                auto acc0 = V::zero(), acc1 = V::zero(), acc2 = V::zero(), acc3 = V::zero();
+                std::size_t i = 0;
+
+                for (; i + 4u * V::lanes <= count; i += 4u * V::lanes)
+                {
+                    acc0 = V::add(acc0, V::load(data + i));
+                    acc1 = V::add(acc1, V::load(data + i + V::lanes));
+                    acc2 = V::add(acc2, V::load(data + i + 2u * V::lanes));
+                    acc3 = V::add(acc3, V::load(data + i + 3u * V::lanes));
+                }
+
+                for (; i + V::lanes <= count; i += V::lanes)
+                    acc0 = V::add(acc0, V::load(data + i));
+
+                acc0 = V::add(V::add(acc0, acc1), V::add(acc2, acc3));
+
+                T lanes[V::lanes];
+                V::store(lanes, acc0);
+
+                sum_type<T> total {};
+
+                for (std::size_t l = 0; l < V::lanes; l++)
+                    total += static_cast<sum_type<T>>(lanes[l]);
+
+                for (; i < count; i++)
+                    total += static_cast<sum_type<T>>(data[i]);
+
+                return static_cast<T>(total);
+            }
+        };
+
+        //Finds the smallest (or, with Max, largest) value of a non-empty range.
+        template<bool Max>
+        struct extreme_kernel
+        {
+            template<typename T>
+            static bool better(T a, T b) { if constexpr (Max) return b < a; else return a < b; }
+
+            template<typename T>
+            static T scalar(const T* data, std::size_t count)
+            {
+                T best = data[0];
+
+                for (std::size_t i = 1u; i < count; i++)
+                    if (better(data[i], best)) best = data[i];
+
+                return best;
+            }
+
+            //The last vector is loaded so it ends at the last element, overlapping the one before; min and max
+            //do not mind seeing an element twice, so there is no scalar tail.
+            template<typename V, typename T>
+            static AGGRO_SIMD_INLINE T run(const T* data, std::size_t count)
+            {
+                if constexpr (!V::has_minmax)
+                {
+                    return scalar(data, count);
+                }
+                else
+                {
+                    if (count < V::lanes) return scalar(data, count);
+
+                    auto acc0 = V::load(data), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+                    std::size_t i = V::lanes;
+
+                    for (; i + 4u * V::lanes <= count; i += 4u * V::lanes)
+                    {
+                        acc0 = Max ? V::max(acc0, V::load(data + i)) : V::min(acc0, V::load(data + i));
+                        acc1 = Max ? V::max(acc1, V::load(data + i + V::lanes)) : V::min(acc1, V::load(data + i + V::lanes));
+                        acc2 = Max ? V::max(acc2, V::load(data + i + 2u * V::lanes)) : V::min(acc2, V::load(data + i + 2u * V::lanes));
+                        acc3 = Max ? V::max(acc3, V::load(data + i + 3u * V::lanes)) : V::min(acc3, V::load(data + i + 3u * V::lanes));
+                    }
+
+                    for (; i + V::lanes <= count; i += V::lanes)
+                        acc0 = Max ? V::max(acc0, V::load(data + i)) : V::min(acc0, V::load(data + i));
+
+                    if (i < count)
+                        acc0 = Max ? V::max(acc0, V::load(data + count - V::lanes)) : V::min(acc0, V::load(data + count - V::lanes));
+
+                    acc0 = Max ? V::max(V::max(acc0, acc1), V::max(acc2, acc3)) : V::min(V::min(acc0, acc1), V::min(acc2, acc3));
+
+                    T lanes[V::lanes];
+                    V::store(lanes, acc0);
+
+                    return scalar(lanes, V::lanes);
+                }
+            }
+        };
+
+        struct equal_kernel
+        {
+            template<typename T>
+            static bool scalar(const T* a, const T* b, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    if (!(a[i] == b[i])) return false;
+
+                return true;
+            }
+
+            template<typename V, typename T>
+            static AGGRO_SIMD_INLINE bool run(const T* a, const T* b, std::size_t count)
+            {
+                constexpr std::uint32_t all = (1u << V::lanes) - 1u;
+                std::size_t i = 0;
+
+                for (; i + V::lanes <= count; i += V::lanes)
+                    if (V::eq(V::load(a + i), V::load(b + i)) != all) return false;
+
+                for (; i < count; i++)
+                    if (!(a[i] == b[i])) return false;
+
+                return true;
+            }
+        };
+
+#if AGGRO_SIMD_X86
+        template<typename Kernel, typename T, typename... Args>
+        AGGRO_SIMD_TARGET("sse2") auto run_sse2(Args... args) { return Kernel::template run<sse2_ops<T>>(args...); }
+
+        template<typename Kernel, typename T, typename... Args>
+        AGGRO_SIMD_TARGET("avx2,popcnt") auto run_avx2(Args... args) { return Kernel::template run<avx2_ops<T>>(args...); }
+
+        template<typename Kernel, typename T, typename... Args>
+        AGGRO_SIMD_TARGET("avx512f,popcnt") auto run_avx512(Args... args) { return Kernel::template run<avx512_ops<T>>(args...); }
+#endif
+
+        //Runs the kernel on the active instruction set, or the scalar loop for types without vector kernels.
+        template<typename Kernel, typename T, typename... Args>
+        auto dispatch(Args... args)
+        {
+#if AGGRO_SIMD_X86
+            if constexpr (simd_lane<T>)
+            {
+                switch (simd_active())
+                {
+                case simd_level::avx512: return run_avx512<Kernel, T>(args...);
+                case simd_level::avx2: return run_avx2<Kernel, T>(args...);
+                case simd_level::sse2: return run_sse2<Kernel, T>(args...);
+                default: break;
+                }
+            }
+#endif
+            return Kernel::scalar(args...);
+        }
+
+    } // namespace simd_detail
+
+    /*
+        Search and reduction kernels over contiguous arithmetic ranges. 32 and 64-bit integers, float and double
+        run on the best of SSE2, AVX2 and AVX-512 this machine supports, picked through CPUID the first time one
+        is called; other types and other architectures run a scalar loop with the same results.
+    */
+
+    //Index of the first element equal to 'value', or 'count' if there is none.
+    template<arithmetic T>
+    std::size_t find_index(const T* data, std::size_t count, std::type_identity_t<T> value)
+    {
+        return simd_detail::dispatch<simd_detail::find_kernel, T>(data, count, value);
+    }
+
+    //Index of the first element equal to 'value', or size() if there is none.
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    std::size_t find_index(const Container& container, container_value_t<Container> value)
+    {
+        return find_index(container.data(), container.size(), value);
+    }
+
+    //Returns an optional reference to the first element equal to 'value'.
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    auto find(Container& container, container_value_t<Container> value)
+    {
+        using element = std::remove_reference_t<decltype(*container.data())>;
+
+        const std::size_t index = find_index(container.data(), container.size(), value);
+
+        if (index != container.size())
+            return optional_ref<element>(container.data()[index]);
+        else
+            return optional_ref<element>(nullopt_ref_t<element>());
+    }
+
+    //Number of elements equal to 'value'.
+    template<arithmetic T>
+    std::size_t count(const T* data, std::size_t count, std::type_identity_t<T> value)
+    {
+        return simd_detail::dispatch<simd_detail::count_kernel, T>(data, count, value);
+    }
+
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    std::size_t count(const Container& container, container_value_t<Container> value)
+    {
+        return count(container.data(), container.size(), value);
+    }
+
+    //Sum of every element, 0 for an empty range. Integer sums wrap around.
+    template<arithmetic T>
+    T sum(const T* data, std::size_t count)
+    {
+        return simd_detail::dispatch<simd_detail::sum_kernel, T>(data, count);
+    }
+
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    container_value_t<Container> sum(const Container& container)
+    {
+        return sum(container.data(), container.size());
+    }
+
+    /*
+        Index of the first smallest element, or 'count' for an empty range. The value is found with vector
+        min, then its first occurrence with find_index. Ranges holding a NaN give an unspecified element.
+    */
+    template<arithmetic T>
+    std::size_t min_index(const T* data, std::size_t count)
+    {
+        if (count == 0u) return count;
+
+        const T value = simd_detail::dispatch<simd_detail::extreme_kernel<false>, T>(data, count);
+        const std::size_t index = find_index(data, count, value);
+
+        return (index != count) ? index : 0u;
+    }
+
+    //Index of the first largest element, or 'count' for an empty range.
+    template<arithmetic T>
+    std::size_t max_index(const T* data, std::size_t count)
+    {
+        if (count == 0u) return count;
+
+        const T value = simd_detail::dispatch<simd_detail::extreme_kernel<true>, T>(data, count);
+        const std::size_t index = find_index(data, count, value);
+
+        return (index != count) ? index : 0u;
+    }
+
+    //Returns an optional reference to the first smallest element, empty if the container is.
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    auto min_element(Container& container)
+    {
+        using element = std::remove_reference_t<decltype(*container.data())>;
+
+        if (container.size() != 0u)
+            return optional_ref<element>(container.data()[min_index(container.data(), container.size())]);
+        else
+            return optional_ref<element>(nullopt_ref_t<element>());
+    }
+
+    //Returns an optional reference to the first largest element, empty if the container is.
+    template<contiguous_container Container> requires arithmetic<container_value_t<Container>>
+    auto max_element(Container& container)
+    {
+        using element = std::remove_reference_t<decltype(*container.data())>;
+
+        if (container.size() != 0u)
+            return optional_ref<element>(container.data()[max_index(container.data(), container.size())]);
+        else
+            return optional_ref<element>(nullopt_ref_t<element>());
+    }
+
+    //True if a[i] == b[i] for every i below 'count'.
+    template<arithmetic T>
+    bool equal(const T* a, const T* b, std::size_t count)
+    {
+        return simd_detail::dispatch<simd_detail::equal_kernel, T>(a, b, count);
+    }
+
+    //True if both containers have the same size and equal elements.
+    template<contiguous_container A, contiguous_container B>
+        requires arithmetic<container_value_t<A>> && same<container_value_t<A>, container_value_t<B>>
+    bool equal(const A& a, const B& b)
+    {
+        return a.size() == b.size() && equal(a.data(), b.data(), a.size());
+    }
+
+} // namespace aggro
+
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
+
+#endif // AGGRO_ALGORITHM_HPP
@@ -0,0 +1,304 @@
+#ifndef ARENAALLOCATOR_HPP
+#define ARENAALLOCATOR_HPP
+
+#include <new>
+#include <cstdint>
+#include "../concepts/allocator.hpp"
+#include "../utility.hpp"
+
+namespace aggro
+{
+    /*
+        A bump-pointer memory arena. Allocations are carved linearly out of large blocks and are never
+        given back individually; the whole arena is reclaimed at once with reset() or release().
+        If the arena is chained, a new block is linked in whenever the current one runs out. Otherwise
+        allocate() returns nullptr once the first block is full.
+    */
+    class memory_arena
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type default_block_size = 64u * 1024u;
+
+    private:
+        struct block
+        {
+            block* prev = nullptr; //The block that was filled before this one.
+            size_type size = 0u;   //Usable bytes following the header.
+        };
+
+        static constexpr size_type header_size =
+            (sizeof(block) + alignof(std::max_align_t) - 1u) & ~(alignof(std::max_align_t) - 1u);
+
+        block* m_block = nullptr;       //The block currently being bumped.
+        unsigned char* m_top = nullptr; //Next free byte in the current block.
+        unsigned char* m_end = nullptr; //One past the last byte of the current block.
+        size_type m_block_size = default_block_size;
+        size_type m_used = 0u;
+        size_type m_reserved = 0u;
+        bool m_chained = true;
+
+        static unsigned char* block_data(block* blk)
+        {
+            return reinterpret_cast<unsigned char*>(blk) + header_size;
+        }
+
+        //Links a new block of at least 'bytes' usable bytes in front of the current one.
+        bool add_block(size_type bytes)
+        {
+            if (m_block && !m_chained) return false;
+
+            const size_type size = (bytes > m_block_size) ? bytes : m_block_size;
+            block* blk = static_cast<block*>(::operator new(header_size + size));
+            blk->prev = m_block;
+            blk->size = size;
+
+            m_block = blk;
+            m_top = block_data(blk);
+            m_end = m_top + size;
+            m_reserved += size;
+
+            return true;
+        }
+
+        static void free_block(block* blk)
+        {
+            ::operator delete(blk, header_size + blk->size);
+        }
+
+    public:
+        //Creates an empty arena. No memory is reserved until the first allocation.
+        explicit memory_arena(size_type block_size = default_block_size, bool chained = true)
+            : m_block_size(block_size > 0u ? block_size : 1u), m_chained(chained)
+        {}
+
+        memory_arena(const memory_arena&) = delete;
+        memory_arena& operator=(const memory_arena&) = delete;
+
+        ~memory_arena() { release(); }
+
+        //Returns 'bytes' of memory aligned to 'align', or nullptr if the arena cannot grow.
+        [[nodiscard]] void* allocate(size_type bytes, size_type align = alignof(std::max_align_t))
+        {
+            auto aligned = [align](unsigned char* ptr) -> unsigned char* {
+                const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+                return ptr + (((addr + align - 1u) & ~(std::uintptr_t)(align - 1u)) - addr);
+            };
+
+            unsigned char* spot = (m_block) ? aligned(m_top) : nullptr;
+
+            if (spot == nullptr || spot + bytes > m_end)
+            {
+                if (!add_block(bytes + align)) return nullptr;
+                spot = aligned(m_top);
+            }
+
+            m_used += static_cast<size_type>(spot + bytes - m_top);
+            m_top = spot + bytes;
+
+            return spot;
+        }
+
+        //Grows the most recent allocation in place if the current block has room.
+        //Returns false if 'ptr' is not the most recent allocation or the block is full.
+        bool expand(void* ptr, size_type old_bytes, size_type new_bytes)
+        {
+            unsigned char* spot = static_cast<unsigned char*>(ptr);
+
+            if (spot == nullptr || spot + old_bytes != m_top || spot + new_bytes > m_end)
+                return false;
+
+            m_used += new_bytes - old_bytes;
+            m_top = spot + new_bytes;
+
+            return true;
+        }
+
+        //Rewinds the arena so its memory can be handed out again. If the arena had spilled
+        //into several blocks, they are merged into one so the next cycle runs without chaining.
+        void reset()
+        {
+            if (m_block == nullptr) return;
+
+            if (m_block->prev)
+            {
+                const size_type total = m_reserved;
+                release();
+                add_block(total);
+            }
+            else
+            {
+                m_top = block_data(m_block);
+            }
+
+            m_used = 0u;
+        }
+
+        //Returns every block to the system.
+        void release()
+        {
+            while (m_block)
+            {
+                block* prev = m_block->prev;
+                free_block(m_block);
+                m_block = prev;
+            }
+
+            m_top = nullptr;
+            m_end = nullptr;
+            m_used = 0u;
+            m_reserved = 0u;
+        }
+
+        //Bytes handed out since the last reset, including alignment padding.
+        size_type used() const { return m_used; }
+
+        //Bytes currently held from the system.
+        size_type reserved() const { return m_reserved; }
+
+        //The arena used by default-constructed arena allocators on the calling thread.
+        static memory_arena& local()
+        {
+            thread_local memory_arena arena;
+            return arena;
+        }
+    };
+
+    /*
+        Contiguous allocator that draws from a memory_arena. Deallocation does nothing; memory
+        is reclaimed when the arena is reset or released. Uses memory_arena::local() unless
+        another arena is set with set_arena().
+    */
+    template<typename T>
+    struct arena_contiguous_allocator
+    {
+        using size_type = std::size_t;
+        using memory_resource = T*;
+        using value_type = T;
+
+    private:
+        memory_arena* m_arena = &memory_arena::local(); //Arena the buffers are carved from.
+        memory_resource m_buffer = nullptr; //Pointer to the beginning of the memory buffer.
+
+    public:
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() { return m_buffer; }
+
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() const { return m_buffer; }
+
+        //Sets the underlying pointer to a new memory buffer.
+        constexpr void set_res(memory_resource other) { m_buffer = other; }
+
+        //Returns the arena this allocator draws from.
+        constexpr memory_arena* arena() const { return m_arena; }
+
+        //Draw future allocations from a different arena.
+        constexpr void set_arena(memory_arena& other) { m_arena = &other; }
+
+        //Allocate a new memory buffer from the arena.
+        [[nodiscard]] constexpr memory_resource allocate(size_type amount)
+        {
+            return static_cast<memory_resource>(m_arena->allocate(amount * sizeof(T), alignof(T)));
+        }
+
+        //Grows the buffer in place if it was the arena's most recent allocation.
+        constexpr bool expand(memory_resource start, size_type size, size_type new_size)
+        {
+            return m_arena->expand(start, size * sizeof(T), new_size * sizeof(T));
+        }
+
+        //Does nothing. Arena memory is reclaimed all at once.
+        constexpr void deallocate(memory_resource, size_type) {}
+
+        //Construct an object at the specified location using placement new.
+        template<typename... Args>
+        constexpr void construct(memory_resource spot, Args&&... args)
+        {
+            new(spot) value_type(aggro::forward<Args>(args)...);
+        }
+    };
+
+    /*
+        Node allocator that draws from a memory_arena. Deallocation does nothing; memory
+        is reclaimed when the arena is reset or released. Uses memory_arena::local() unless
+        another arena is set with set_arena().
+    */
+    template<typename T>
+    struct arena_node_allocator
+    {
+        using size_type = std::size_t;
+        using memory_resource = T*;
+        using value_type = typename T::value_type;
+
+    private:
+        memory_arena* m_arena = &memory_arena::local(); //Arena the nodes are carved from.
+        memory_resource m_head_node = nullptr; //Pointer to the head node.
+        memory_resource m_tail_node = nullptr; //Pointer to the tail node.
+
+    public:
+        //Returns a pointer to the head node.
+        constexpr memory_resource resource() { return m_head_node; }
+
+        //Returns a pointer to the head node.
+        constexpr memory_resource resource() const { return m_head_node; }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() { return m_tail_node; }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() const { return m_tail_node; }
+
+        //Changes the head node.
+        constexpr void set_head(memory_resource node) { m_head_node = node; }
+
+        //Changes the tail node.
+        constexpr void set_tail(memory_resource node) { m_tail_node = node; }
+
+        //Remove all pointers from this allocator.
+        constexpr void unlink()
+        {
+            m_head_node = nullptr;
+            m_tail_node = nullptr;
+        }
+
+        //Returns the arena this allocator draws from.
+        constexpr memory_arena* arena() const { return m_arena; }
+
+        //Draw future allocations from a different arena.
+        constexpr void set_arena(memory_arena& other) { m_arena = &other; }
+
+        //Allocates new nodes from the arena and returns a pointer to the first one.
+        [[nodiscard]] constexpr memory_resource allocate(size_type amount)
+        {
+            return static_cast<memory_resource>(m_arena->allocate(amount * sizeof(T), alignof(T)));
+        }
+
+        //Allocates 'amount' nodes in one block. Nodes are never freed one by one, so this is the same as allocate().
+        [[nodiscard]] constexpr memory_resource allocate_batch(size_type amount)
+        {
+            return allocate(amount);
+        }
+
+        //Does nothing. Arena memory is reclaimed all at once.
+        constexpr void deallocate(memory_resource, size_type) {}
+
+        //Constructs an object into the specified node using placement new.
+        template<typename... Args>
+        constexpr void construct(memory_resource spot, Args&&... args)
+        {
+            new(&(spot->value)) value_type(aggro::forward<Args>(args)...);
+        }
+
+        //Constructs an object into the specified location using placement new.
+        template<typename... Args>
+        constexpr void construct(value_type* spot, Args&&... args)
+        {
+            new(spot) value_type(aggro::forward<Args>(args)...);
+        }
+    };
+
+} // namespace aggro
+
+#endif // ARENAALLOCATOR_HPP
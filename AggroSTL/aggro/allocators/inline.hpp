@@ -0,0 +1,82 @@
+#ifndef INLINEALLOCATOR_HPP
+#define INLINEALLOCATOR_HPP
+
+#include "standard.hpp"
+
+namespace aggro
+{
+    /*
+        Contiguous allocator with room for N elements inside the allocator itself. Requests that fit
+        are served from the inline buffer while it is free; anything larger goes to the Fallback allocator.
+        Containers that hold this allocator therefore make no heap allocations until they outgrow N elements.
+    */
+    template<typename T, std::size_t N, standard_allocator Fallback = std_contiguous_allocator<T>>
+    struct inline_contiguous_allocator
+    {
+        using size_type = std::size_t;
+        using memory_resource = T*;
+        using value_type = T;
+
+        static constexpr size_type inline_capacity = N;
+
+    private:
+        Fallback m_fallback; //Serves requests that do not fit inline.
+        memory_resource m_buffer = nullptr; //Pointer to the beginning of the memory buffer.
+        alignas(T) unsigned char m_storage[N * sizeof(T)]; //Uninitialized inline buffer.
+
+    public:
+        constexpr inline_contiguous_allocator() = default;
+
+        //Inline storage belongs to a single container, so it is never copied.
+        constexpr inline_contiguous_allocator(const inline_contiguous_allocator&) {}
+        constexpr inline_contiguous_allocator& operator=(const inline_contiguous_allocator&) { return *this; }
+
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() { return m_buffer; }
+
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() const { return m_buffer; }
+
+        //Sets the underlying pointer to a new memory buffer.
+        constexpr void set_res(memory_resource other) { m_buffer = other; }
+
+        //Returns a pointer to the inline buffer.
+        constexpr memory_resource inline_buffer() { return reinterpret_cast<memory_resource>(m_storage); }
+
+        //Does the pointer refer to the inline buffer?
+        constexpr bool is_inline(const T* spot) const
+        {
+            return spot == reinterpret_cast<const T*>(m_storage);
+        }
+
+        //Returns the allocator used once the inline buffer is outgrown.
+        constexpr Fallback* fallback() { return &m_fallback; }
+
+        //Allocate a new memory buffer. The inline buffer is used if it is large enough and not already in use.
+        [[nodiscard]] constexpr memory_resource allocate(size_type amount)
+        {
+            if (amount <= N && !is_inline(m_buffer))
+                return inline_buffer();
+
+            return m_fallback.allocate(amount);
+        }
+
+        //Deallocate a memory resource, specifying the size of the buffer. Does nothing for the inline buffer.
+        constexpr void deallocate(memory_resource start, size_type size)
+        {
+            if (is_inline(start)) return;
+
+            m_fallback.deallocate(start, size);
+        }
+
+        //Construct an object at the specified location using placement new.
+        template<typename... Args>
+        constexpr void construct(memory_resource spot, Args&&... args)
+        {
+            new(spot) value_type(aggro::forward<Args>(args)...);
+        }
+    };
+
+} // namespace aggro
+
+#endif // INLINEALLOCATOR_HPP
@@ -0,0 +1,267 @@
+#ifndef POOLALLOCATOR_HPP
+#define POOLALLOCATOR_HPP
+
+#include <cstdint>
+#include <new>
+#include "../concepts/allocator.hpp"
+#include "../utility.hpp"
+
+namespace aggro
+{
+    /*
+        A pool of fixed-size nodes. Nodes are carved out of large slabs, and freed nodes are kept on an
+        intrusive free list so the next allocation can reuse them without touching the heap.
+        Slabs are only returned to the system when the pool is released or destroyed.
+    */
+    template<typename T>
+    class node_pool
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type default_slab_nodes = 64u;
+        static constexpr size_type max_slab_nodes = 4096u;
+
+    private:
+        static_assert(sizeof(T) >= sizeof(void*), "Pooled nodes must be able to hold a free list link.");
+
+        //A freed node reinterpreted as a link in the free list.
+        struct free_node
+        {
+            free_node* next;
+        };
+
+        struct slab
+        {
+            slab* prev = nullptr; //The slab that was carved before this one.
+            size_type count = 0u; //Number of nodes the slab holds.
+        };
+
+        static constexpr size_type header_size = (sizeof(slab) + alignof(T) - 1u) & ~(alignof(T) - 1u);
+
+        free_node* m_free = nullptr; //Head of the free list.
+        slab* m_slab = nullptr;      //Slab currently being carved.
+        T* m_top = nullptr;          //Next uncarved node in the current slab.
+        T* m_end = nullptr;          //One past the last node in the current slab.
+        size_type m_slab_nodes = default_slab_nodes;
+
+        static T* slab_data(slab* s)
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(s) + header_size);
+        }
+
+        //Links a new slab holding at least 'amount' nodes. Whatever is left of the current slab goes on the free list.
+        void add_slab(size_type amount)
+        {
+            for (T* node = m_top; node != m_end; ++node)
+            {
+                free_node* spare = reinterpret_cast<free_node*>(node);
+                spare->next = m_free;
+                m_free = spare;
+            }
+
+            const size_type count = (amount > m_slab_nodes) ? amount : m_slab_nodes;
+            slab* s = static_cast<slab*>(::operator new(header_size + count * sizeof(T)));
+
+            s->prev = m_slab;
+            s->count = count;
+
+            m_slab = s;
+            m_top = slab_data(s);
+            m_end = m_top + count;
+
+            if (m_slab_nodes < max_slab_nodes) m_slab_nodes *= 2u;
+        }
+
+        /*
+            Takes 'amount' nodes off the free list if the first 'amount' of them sit next to each other in memory,
+            as they do once a list built from one batch has been cleared. Returns the lowest one, or nullptr if
+            the run is broken, in which case the free list is left alone.
+        */
+        T* take_free_run(size_type amount)
+        {
+            if (m_free == nullptr || m_free->next == nullptr) return nullptr;
+
+            const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(m_free);
+            const std::uintptr_t second = reinterpret_cast<std::uintptr_t>(m_free->next);
+            const bool ascending = second > first;
+
+            if ((ascending ? second - first : first - second) != sizeof(T)) return nullptr;
+
+            free_node* node = m_free;
+
+            for (size_type i = 1u; i < amount; i++)
+            {
+                node = node->next;
+                if (node == nullptr) return nullptr;
+
+                const std::uintptr_t expected = ascending ? first + i * sizeof(T) : first - i * sizeof(T);
+                if (reinterpret_cast<std::uintptr_t>(node) != expected) return nullptr;
+            }
+
+            m_free = node->next;
+
+            return reinterpret_cast<T*>(ascending ? first : reinterpret_cast<std::uintptr_t>(node));
+        }
+
+    public:
+        //Creates an empty pool. The first slab holds 'slab_nodes' nodes and later slabs double
+        //in size up to max_slab_nodes.
+        explicit node_pool(size_type slab_nodes = default_slab_nodes)
+            : m_slab_nodes(slab_nodes > 0u ? slab_nodes : 1u)
+        {}
+
+        node_pool(const node_pool&) = delete;
+        node_pool& operator=(const node_pool&) = delete;
+
+        ~node_pool() { release(); }
+
+        /*
+            Returns 'amount' contiguous nodes. Single nodes are taken from the free list first. Larger requests
+            reuse the top of the free list when it is one unbroken run, and are carved from a slab otherwise.
+        */
+        [[nodiscard]] T* allocate(size_type amount)
+        {
+            if (amount == 1u && m_free)
+            {
+                free_node* node = m_free;
+                m_free = node->next;
+
+                return reinterpret_cast<T*>(node);
+            }
+
+            if (amount > 1u)
+            {
+                if (T* run = take_free_run(amount)) return run;
+            }
+
+            if (m_top == nullptr || m_top + amount > m_end)
+            {
+                add_slab(amount);
+            }
+
+            T* spot = m_top;
+            m_top += amount;
+
+            return spot;
+        }
+
+        //Puts 'amount' contiguous nodes back on the free list.
+        void deallocate(T* start, size_type amount)
+        {
+            for (size_type i = 0; i < amount; i++)
+            {
+                free_node* node = reinterpret_cast<free_node*>(start + i);
+                node->next = m_free;
+                m_free = node;
+            }
+        }
+
+        //Returns every slab to the system. All nodes handed out by this pool become invalid.
+        void release()
+        {
+            while (m_slab)
+            {
+                slab* prev = m_slab->prev;
+                ::operator delete(m_slab, header_size + m_slab->count * sizeof(T));
+                m_slab = prev;
+            }
+
+            m_free = nullptr;
+            m_top = nullptr;
+            m_end = nullptr;
+        }
+
+        //The pool used by default-constructed pooled allocators on the calling thread.
+        static node_pool& local()
+        {
+            thread_local node_pool pool;
+            return pool;
+        }
+    };
+
+    /*
+        Node allocator backed by a node_pool. Has the same interface as std_node_allocator, so
+        slist and dlist work with it unchanged. Uses node_pool<T>::local() unless another pool
+        is set with set_pool(). Nodes must be freed on the thread that owns the pool.
+    */
+    template<typename T>
+    struct pooled_node_allocator
+    {
+        using size_type = std::size_t;
+        using memory_resource = T*;
+        using value_type = typename T::value_type;
+
+    private:
+        node_pool<T>* m_pool = &node_pool<T>::local(); //Pool the nodes are drawn from.
+        memory_resource m_head_node = nullptr; //Pointer to the head node.
+        memory_resource m_tail_node = nullptr; //Pointer to the tail node.
+
+    public:
+        //Returns a pointer to the head node.
+        constexpr memory_resource resource() { return m_head_node; }
+
+        //Returns a pointer to the head node.
+        constexpr memory_resource resource() const { return m_head_node; }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() { return m_tail_node; }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() const { return m_tail_node; }
+
+        //Changes the head node.
+        constexpr void set_head(memory_resource node) { m_head_node = node; }
+
+        //Changes the tail node.
+        constexpr void set_tail(memory_resource node) { m_tail_node = node; }
+
+        //Remove all pointers from this allocator.
+        constexpr void unlink()
+        {
+            m_head_node = nullptr;
+            m_tail_node = nullptr;
+        }
+
+        //Returns the pool this allocator draws from.
+        constexpr node_pool<T>* pool() const { return m_pool; }
+
+        //Draw future allocations from a different pool.
+        constexpr void set_pool(node_pool<T>& other) { m_pool = &other; }
+
+        //Takes nodes from the pool and returns a pointer to the first one.
+        [[nodiscard]] constexpr memory_resource allocate(size_type amount)
+        {
+            return m_pool->allocate(amount);
+        }
+
+        //Takes 'amount' nodes that sit next to each other in one slab. Each can be deallocated on its own.
+        [[nodiscard]] constexpr memory_resource allocate_batch(size_type amount)
+        {
+            return m_pool->allocate(amount);
+        }
+
+        //Returns nodes to the pool's free list.
+        constexpr void deallocate(memory_resource start, size_type size)
+        {
+            m_pool->deallocate(start, size);
+        }
+
+        //Constructs an object into the specified node using placement new.
+        template<typename... Args>
+        constexpr void construct(memory_resource spot, Args&&... args)
+        {
+            new(&(spot->value)) value_type(aggro::forward<Args>(args)...);
+        }
+
+        //Constructs an object into the specified location using placement new.
+        template<typename... Args>
+        constexpr void construct(value_type* spot, Args&&... args)
+        {
+            new(spot) value_type(aggro::forward<Args>(args)...);
+        }
+    };
+
+} // namespace aggro
+
+#endif // POOLALLOCATOR_HPP
@@ -42,7 +42,7 @@ namespace aggro
         template<typename... Args>
         constexpr void construct(memory_resource spot, Args&&... args)
         {
-            new(spot) value_type(forward<Args>(args)...);
+            new(spot) value_type(aggro::forward<Args>(args)...);
         }
     };
 
@@ -105,14 +105,14 @@ namespace aggro
         template<typename... Args>
         constexpr void construct(memory_resource spot, Args&&... args)
         {
-            new(&(spot->value)) value_type(forward<Args>(args)...);
+            new(&(spot->value)) value_type(aggro::forward<Args>(args)...);
         }
 
         //Constructs an object into the specified location using placement new.
         template<typename... Args>
         constexpr void construct(value_type* spot, Args&&... args)
         {
-            new(spot) value_type(forward<Args>(args)...);
+            new(spot) value_type(aggro::forward<Args>(args)...);
         }
     };
 
@@ -0,0 +1,180 @@
+#ifndef STATSALLOCATOR_HPP
+#define STATSALLOCATOR_HPP
+
+#include <type_traits>
+#include "standard.hpp"
+
+namespace aggro
+{
+    //Counters kept by a stats_allocator.
+    struct allocator_stats
+    {
+        std::size_t allocations = 0u;
+        std::size_t deallocations = 0u;
+        std::size_t bytes_allocated = 0u;
+        std::size_t bytes_deallocated = 0u;
+        std::size_t largest_block = 0u;  //Largest single allocation in bytes.
+        std::size_t reallocations = 0u;  //Allocations made while a buffer was already held, i.e. the old one is being replaced.
+        std::size_t grows = 0u;          //Times darray::grow() ran out of room and had to grow.
+        std::size_t expansions = 0u;     //Buffers grown in place through expand().
+
+        //Bytes allocated and not yet deallocated.
+        constexpr std::size_t live_bytes() const { return bytes_allocated - bytes_deallocated; }
+    };
+
+    template<typename Inner>
+    struct stats_allocator_base {};
+
+    //Keeps the inline capacity visible so containers still treat the inner buffer as inline.
+    template<typename Inner> requires inline_allocator<Inner>
+    struct stats_allocator_base<Inner>
+    {
+        static constexpr std::size_t inline_capacity = Inner::inline_capacity;
+    };
+
+    /*
+        Wraps any standard allocator and counts what the container asks of it. Everything else is forwarded,
+        so it can be dropped into a darray, deque, list or map without changing behaviour. Read the counters
+        through the container's get_allocator()->stats(), e.g. to spot darrays that should reserve() up front
+        or lists that would benefit from a pool.
+    */
+    template<standard_allocator Inner>
+    struct stats_allocator : stats_allocator_base<Inner>
+    {
+        using size_type = std::size_t;
+        using memory_resource = typename Inner::memory_resource;
+        using value_type = typename Inner::value_type;
+
+    private:
+        using element_type = std::remove_pointer_t<memory_resource>;
+
+        Inner m_inner;
+        allocator_stats m_stats;
+
+    public:
+        //Returns the counters collected so far.
+        constexpr const allocator_stats& stats() const { return m_stats; }
+
+        //Zeroes the counters.
+        constexpr void reset_stats() { m_stats = allocator_stats(); }
+
+        //Returns the wrapped allocator, e.g. to call set_pool() or set_arena() on it.
+        constexpr Inner* inner() { return &m_inner; }
+
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() { return m_inner.resource(); }
+
+        //Returns a pointer to the memory resource.
+        constexpr memory_resource resource() const { return m_inner.resource(); }
+
+        //Sets the underlying pointer to a new memory buffer.
+        constexpr void set_res(memory_resource other) requires requires (Inner i) { i.set_res(memory_resource{}); }
+        {
+            m_inner.set_res(other);
+        }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() requires requires (Inner i) { i.resource_rev(); }
+        {
+            return m_inner.resource_rev();
+        }
+
+        //Returns a pointer to the tail node.
+        constexpr memory_resource resource_rev() const requires requires (const Inner i) { i.resource_rev(); }
+        {
+            return m_inner.resource_rev();
+        }
+
+        //Changes the head node.
+        constexpr void set_head(memory_resource node) requires requires (Inner i) { i.set_head(memory_resource{}); }
+        {
+            m_inner.set_head(node);
+        }
+
+        //Changes the tail node.
+        constexpr void set_tail(memory_resource node) requires requires (Inner i) { i.set_tail(memory_resource{}); }
+        {
+            m_inner.set_tail(node);
+        }
+
+        //Remove all pointers from this allocator.
+        constexpr void unlink() requires requires (Inner i) { i.unlink(); }
+        {
+            m_inner.unlink();
+        }
+
+        [[nodiscard]] constexpr memory_resource allocate(size_type amount)
+        {
+            const size_type bytes = amount * sizeof(element_type);
+
+            if constexpr (requires (Inner i) { i.set_res(memory_resource{}); })
+            {
+                if (m_inner.resource() != nullptr) ++m_stats.reallocations;
+            }
+
+            ++m_stats.allocations;
+            m_stats.bytes_allocated += bytes;
+            if (bytes > m_stats.largest_block) m_stats.largest_block = bytes;
+
+            return m_inner.allocate(amount);
+        }
+
+        //Counts a batch of nodes as one allocation.
+        [[nodiscard]] constexpr memory_resource allocate_batch(size_type amount) requires batch_allocator<Inner>
+        {
+            const size_type bytes = amount * sizeof(element_type);
+
+            ++m_stats.allocations;
+            m_stats.bytes_allocated += bytes;
+            if (bytes > m_stats.largest_block) m_stats.largest_block = bytes;
+
+            return m_inner.allocate_batch(amount);
+        }
+
+        constexpr void deallocate(memory_resource start, size_type size)
+        {
+            if (start == nullptr) return;
+
+            ++m_stats.deallocations;
+            m_stats.bytes_deallocated += size * sizeof(element_type);
+
+            m_inner.deallocate(start, size);
+        }
+
+        //Grows the buffer in place if the inner allocator can.
+        constexpr bool expand(memory_resource start, size_type size, size_type new_size) requires expandable_allocator<Inner>
+        {
+            if (!m_inner.expand(start, size, new_size)) return false;
+
+            ++m_stats.expansions;
+            m_stats.bytes_allocated += (new_size - size) * sizeof(element_type);
+
+            return true;
+        }
+
+        //Does the pointer refer to the inner allocator's inline buffer?
+        constexpr bool is_inline(const element_type* spot) const requires inline_allocator<Inner>
+        {
+            return m_inner.is_inline(spot);
+        }
+
+        //Called by darray::grow().
+        constexpr void record_grow() { ++m_stats.grows; }
+
+        template<typename... Args>
+        constexpr void construct(memory_resource spot, Args&&... args)
+        {
+            m_inner.construct(spot, aggro::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        constexpr void construct(value_type* spot, Args&&... args)
+            requires (same<value_type*, memory_resource> == false)
+        {
+            m_inner.construct(spot, aggro::forward<Args>(args)...);
+        }
+    };
+
+} // namespace aggro
+
+#endif // STATSALLOCATOR_HPP
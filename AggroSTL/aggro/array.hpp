@@ -1,8 +1,13 @@
+#ifndef AGGRO_ARRAY_HPP
+#define AGGRO_ARRAY_HPP
+
 #include <initializer_list>
+#include <cstring>
 #include "utility.hpp"
 #include "optional.hpp"
 #include "concepts/stream.hpp"
 #include "allocators/standard.hpp"
+#include "allocators/inline.hpp"
 
 namespace aggro
 {
@@ -87,6 +92,7 @@ namespace aggro
 		constexpr size_type bytes() const { return N * sizeof(T); }
 
 		constexpr T* data() { return m_data; }
+		constexpr const T* data() const { return m_data; }
 
 		//Returns an optional reference to the object at 'index' location
 		//provided that the value is within bounds.
@@ -115,6 +121,26 @@ namespace aggro
 		
 	};
 
+	//Capacity a growable array moves to once 'cap' is full. With an expand_factor of 1.0f or less the
+	//capacity grows by one, otherwise it is multiplied by expand_factor.
+	inline constexpr std::size_t grown_capacity(std::size_t cap, float expand_factor)
+	{
+		std::size_t nCap;
+
+		if(expand_factor <= 1.0f)
+		{
+			nCap = cap + 1;
+		}
+		else
+		{
+			nCap = static_cast<std::size_t>((float)cap * expand_factor);
+
+			if(nCap == cap) ++nCap;
+		}
+
+		return (nCap > 0u) ? nCap : 1u;
+	}
+
 	/*
 		Dynamically allocated array which replaces std::vector. By default darrays grow exponentially, reducing reallocations.
 		The method used to resize the array upon adding a new element can be changed using the expand_factor member variable.
@@ -149,45 +175,90 @@ namespace aggro
 		template<typename... Args>
 		constexpr void _emplace(T* spot, Args&&... args)
 		{
-			alloc.construct(spot, forward<Args>(args)...);
+			alloc.construct(spot, aggro::forward<Args>(args)...);
 		}
 
-		constexpr void grow()
+		//Moves 'num' elements from 'src' to 'dest' and destroys the originals. The ranges may overlap
+		//as long as 'dest' comes before 'src'. Trivially relocatable types are moved with one memmove.
+		constexpr void relocate(T* dest, T* src, size_type num)
 		{
-			T* temp = alloc.resource();
-			size_type nCap, oCap;
-
-			auto decide = [](size_type test) -> size_type {
-				if (test > 0u)
-					return test;
-				else
-					return 1u;
-			};
-
-			if(expand_factor <= 1.0f)
+			if constexpr (trivially_relocatable<T>)
 			{
-				nCap = decide(m_capacity + 1);
+				if (num > 0u) std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), num * sizeof(T));
 			}
 			else
 			{
-				size_type test_cap = static_cast<size_type>((float)m_capacity * expand_factor);
+				for (size_type i = 0; i < num; i++)
+				{
+					_emplace(dest + i, move(src[i]));
+					src[i].~T();
+				}
+			}
+		}
 
-				if(test_cap == m_capacity) ++test_cap;
+		//Moves the elements into a new buffer of 'cap' elements, growing in place if the allocator can.
+		constexpr void reallocate(size_type cap)
+		{
+			T* temp = alloc.resource();
 
-				nCap = decide(test_cap);
+			if constexpr (expandable_allocator<Alloc>)
+			{
+				if (cap > m_capacity && temp != nullptr && alloc.expand(temp, m_capacity, cap))
+				{
+					m_capacity = cap;
+					return;
+				}
 			}
 
-			alloc.set_res(alloc.allocate(nCap));
-			oCap = m_capacity;
-			m_capacity = nCap;
+			alloc.set_res(alloc.allocate(cap));
+			relocate(alloc.resource(), temp, m_count);
+			alloc.deallocate(temp, m_capacity);
+
+			m_capacity = cap;
+		}
 
-			for (size_type i = 0; i < m_count; i++)
+		//Smallest capacity worth allocating. Inline allocators hand out their whole buffer at once.
+		static constexpr size_type min_capacity(size_type cap)
+		{
+			if constexpr (inline_allocator<Alloc>)
+				return (cap < Alloc::inline_capacity) ? Alloc::inline_capacity : cap;
+			else
+				return cap;
+		}
+
+		//Takes over the buffer of another darray, leaving it empty.
+		//Elements held in the other array's inline buffer are moved over one at a time.
+		constexpr void take_buffer(darray& other)
+		{
+			m_count = other.size();
+			m_capacity = other.capacity();
+
+			if constexpr (inline_allocator<Alloc>)
 			{
-				_emplace(&alloc.resource()[i], move(temp[i]));
-				temp[i].~T();
+				if (other.alloc.is_inline(other.data()))
+				{
+					alloc.set_res(alloc.allocate(m_capacity));
+
+					for (size_type i = 0; i < m_count; i++)
+						_emplace(&alloc.resource()[i], move(other.data()[i]));
+
+					other.clear();
+					return;
+				}
 			}
 
-			alloc.deallocate(temp, oCap);
+			alloc.set_res(other.data());
+			nullify_array(other);
+		}
+
+		constexpr void grow()
+		{
+			const size_type nCap = grown_capacity(m_capacity, expand_factor);
+
+			if constexpr (growth_tracking_allocator<Alloc>)
+				alloc.record_grow();
+
+			reallocate(min_capacity(nCap));
 		}
 
 		//Defragments the array after erasing elements.
@@ -195,19 +266,18 @@ namespace aggro
 		{
 			if(hole_end == end_ptr) return;
 
-			while(hole_end != end_ptr)
-			{
-				_emplace(hole_start, move(*hole_end));
-				hole_end->~T();
-
-				++hole_start;
-				++hole_end;
-			}
+			relocate(hole_start, hole_end, static_cast<size_type>(end_ptr - hole_end));
 		}
 
 	public:
 
-		friend inline constexpr void nullify_array(darray& arr);
+		//Used for move operations.
+		friend inline constexpr void nullify_array(darray& arr)
+		{
+			arr.m_count = 0;
+			arr.m_capacity = 0;
+			arr.alloc.set_res(nullptr);
+		}
 
 		float expand_factor = 1.0f;
 
@@ -216,17 +286,17 @@ namespace aggro
 		//Allocates a buffer of 'cap' size.
 		//Does not construct any objects.
 		constexpr darray(size_type cap)
-			:m_capacity(cap)
+			:m_capacity(min_capacity(cap))
 		{
-			alloc.set_res(alloc.allocate(cap));
+			alloc.set_res(alloc.allocate(m_capacity));
 		}
 
 		//Allocates a buffer of'inits.size()' size and moves the provided objects into it.
 		constexpr darray(std::initializer_list<T>&& inits)
-			:m_count(0), m_capacity(inits.size())
+			:m_count(0), m_capacity(min_capacity(inits.size()))
 		{
 			alloc.set_res(alloc.allocate(m_capacity));
-			for (size_type i = 0; i < m_capacity; i++)
+			for (size_type i = 0; i < inits.size(); i++)
 			{
 				_emplace(&alloc.resource()[i], move(*(inits.begin() + i)));
 				++m_count;
@@ -234,7 +304,7 @@ namespace aggro
 		}
 
 		constexpr darray(const darray& other)
-			:m_count(other.size()), m_capacity(other.capacity())
+			:m_count(other.size()), m_capacity(min_capacity(other.capacity()))
 		{
 			alloc.set_res(alloc.allocate(m_capacity));
 
@@ -248,10 +318,8 @@ namespace aggro
 		}
 
 		constexpr darray(darray&& other) noexcept
-			:m_count(other.size()), m_capacity(other.capacity())
 		{
-			alloc.set_res(other.data());
-			nullify_array(other);
+			take_buffer(other);
 		}
 
 		constexpr T& operator[](size_type index)
@@ -270,10 +338,10 @@ namespace aggro
 			{
 				clear();
 				alloc.deallocate(alloc.resource(), m_capacity);
-
+				alloc.set_res(nullptr);
 
 				m_count = other.size();
-				m_capacity = other.capacity();
+				m_capacity = min_capacity(other.capacity());
 
 				alloc.set_res(alloc.allocate(m_capacity));
 
@@ -295,13 +363,9 @@ namespace aggro
 			{
 				clear();
 				alloc.deallocate(alloc.resource(), m_capacity);
+				alloc.set_res(nullptr);
 
-				m_count = other.size();
-				m_capacity = other.capacity();
-
-				alloc.set_res(other.data());
-
-				nullify_array(other);
+				take_buffer(other);
 			}
 
 			return *this;
@@ -314,11 +378,12 @@ namespace aggro
 			if(list.size() > capacity())
 			{
 				alloc.deallocate(alloc.resource(), m_capacity);
-				m_capacity = list.size();
+				alloc.set_res(nullptr);
+				m_capacity = min_capacity(list.size());
 				alloc.set_res(alloc.allocate(m_capacity));
 			}
 
-			for (size_type i = 0; i < m_capacity; i++)
+			for (size_type i = 0; i < list.size(); i++)
 			{
 				_emplace(&alloc.resource()[i], move(*(list.begin() + i)));
 				++m_count;
@@ -368,6 +433,12 @@ namespace aggro
 			return m_count * sizeof(T);
 		}
 
+		//Get a pointer to the underlying allocator.
+		constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+		//Get a pointer to the underlying allocator.
+		constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+
 		//Return raw pointer to the array data.
 		constexpr const T* data() const { return alloc.resource(); }
 		constexpr T* data() { return alloc.resource(); }
@@ -390,19 +461,10 @@ namespace aggro
 		//Reallocate enough memory for the provided number of elements.
 		constexpr void reserve(size_type cap)
 		{
-			T* temp = alloc.resource();
+			cap = min_capacity(cap);
+			if (cap == m_capacity) return;
 
-			alloc.set_res(alloc.allocate(cap));
-
-			for (size_type i = 0; i < m_count; i++)
-			{
-				_emplace(&alloc.resource()[i], move(temp[i]));
-				temp[i].~T();
-			}
-
-			alloc.deallocate(temp, m_capacity);
-
-			m_capacity = cap;
+			reallocate(cap);
 		}
 
 		//Resizes the array to a specified size. Elements beyond the specified count are deleted.
@@ -458,7 +520,7 @@ namespace aggro
 			if (m_count >=m_capacity)
 				grow();
 
-			_emplace(&alloc.resource()[m_count], forward<Args>(args)...);
+			_emplace(&alloc.resource()[m_count], aggro::forward<Args>(args)...);
 
 			++m_count;
 			return back();
@@ -505,14 +567,12 @@ namespace aggro
 		}
 	};
 
-	//Used for move operations.
-	template<typename T>
-	inline constexpr void nullify_array(darray<T>& arr)
-	{
-		arr.count = 0;
-		arr.capacity = 0;
-		arr.alloc.set_res(nullptr);
-	}
+	/*
+		A darray that keeps up to N elements in an inline buffer and only moves to memory from Alloc
+		once it holds more than that.
+	*/
+	template<typename T, std::size_t N, standard_allocator Alloc = std_contiguous_allocator<T>>
+	using small_darray = darray<T, inline_contiguous_allocator<T, N, Alloc>>;
 
 	template<os_compatible T, size_t N>
 	inline constexpr std::ostream& operator<<(std::ostream& stream, const array<T, N>& obj)
@@ -527,8 +587,8 @@ namespace aggro
 		return stream;
 	}
 
-	template<os_compatible T>
-	inline constexpr std::ostream& operator<<(std::ostream& stream, const darray<T>& obj)
+	template<os_compatible T, standard_allocator Alloc>
+	inline constexpr std::ostream& operator<<(std::ostream& stream, const darray<T, Alloc>& obj)
 	{
 		stream << "{ ";
 
@@ -546,3 +606,5 @@ namespace aggro
 		return stream;
 	}
 }
+
+#endif // AGGRO_ARRAY_HPP
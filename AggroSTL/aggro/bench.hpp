@@ -0,0 +1,366 @@
+#ifndef AGGRO_BENCH_HPP
+#define AGGRO_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace aggro::bench
+{
+    using size_type = std::size_t;
+    using clock = std::chrono::steady_clock;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    //Forces the compiler to assume 'value' is read, so the code computing it cannot be removed.
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        static const volatile void* sink;
+        sink = &value;
+        _ReadWriteBarrier();
+    }
+
+    //Forces the compiler to assume all memory is read and written at this point.
+    inline void clobber_memory() { _ReadWriteBarrier(); }
+#else
+    //Forces the compiler to assume 'value' is read, so the code computing it cannot be removed.
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+
+    //Forces the compiler to assume 'value' is read and modified, so it cannot be kept in a register
+    //across iterations or folded away.
+    template<typename T>
+    inline void do_not_optimize(T& value)
+    {
+        asm volatile("" : "+m"(value) : : "memory");
+    }
+
+    //Forces the compiler to assume all memory is read and written at this point.
+    inline void clobber_memory() { asm volatile("" : : : "memory"); }
+#endif
+
+    /*
+        Passed to every benchmark function. The function runs its measured loop with
+        'while (s.keep_running())' and reads its problem size from range(). Setup that should not
+        be timed can be wrapped in pause_timing()/resume_timing().
+    */
+    class state
+    {
+        size_type m_range;
+        size_type m_iterations;
+        size_type m_remaining;
+        size_type m_ops = 1u;
+
+        clock::time_point m_start;
+        clock::duration m_elapsed{};
+        bool m_started = false;
+        bool m_running = false;
+
+    public:
+        constexpr state(size_type range, size_type iterations)
+            : m_range(range), m_iterations(iterations), m_remaining(iterations)
+        {}
+
+        //Returns true while there are iterations left. The clock starts on the first call
+        //and stops once the last iteration has finished.
+        bool keep_running()
+        {
+            if (m_remaining > 0u)
+            {
+                if (!m_started)
+                {
+                    m_started = true;
+                    resume_timing();
+                }
+
+                --m_remaining;
+                return true;
+            }
+
+            pause_timing();
+            return false;
+        }
+
+        void pause_timing()
+        {
+            if (!m_running) return;
+
+            m_elapsed += clock::now() - m_start;
+            m_running = false;
+        }
+
+        void resume_timing()
+        {
+            if (m_running) return;
+
+            m_running = true;
+            m_start = clock::now();
+        }
+
+        //The problem size this run was registered with.
+        constexpr size_type range() const { return m_range; }
+
+        constexpr size_type iterations() const { return m_iterations; }
+
+        //Number of operations one iteration performs. Reported times are divided by it.
+        constexpr void set_ops_per_iteration(size_type ops) { m_ops = (ops > 0u) ? ops : 1u; }
+
+        constexpr size_type ops_per_iteration() const { return m_ops; }
+
+        constexpr clock::duration elapsed() const { return m_elapsed; }
+    };
+
+    using bench_func = void (*)(state&);
+
+    struct bench_case
+    {
+        const char* name;
+        bench_func func;
+        std::vector<size_type> ranges;
+    };
+
+    //Timing of one case at one range, in nanoseconds per operation.
+    struct bench_result
+    {
+        std::string name;
+        size_type range = 0u;
+        size_type iterations = 0u;
+        size_type repetitions = 0u;
+        double mean = 0.0;
+        double median = 0.0;
+        double stddev = 0.0;
+    };
+
+    enum class output_format { console, json, csv };
+
+    struct options
+    {
+        std::string filter;                     //Only cases whose name contains this string run.
+        size_type repetitions = 5u;             //Measured runs per case after calibration.
+        double min_time = 0.1;                  //Seconds a single run should take at least.
+        size_type max_iterations = 1000000000u;
+        output_format format = output_format::console;
+        std::string out;                        //File to write results to. Empty means stdout.
+    };
+
+    //Every case registered with AGGRO_BENCHMARK, in registration order.
+    inline std::vector<bench_case>& registry()
+    {
+        static std::vector<bench_case> cases;
+        return cases;
+    }
+
+    struct registrar
+    {
+        registrar(const char* name, bench_func func, std::initializer_list<size_type> ranges)
+        {
+            registry().push_back(bench_case{ name, func, ranges.size() > 0u ? std::vector<size_type>(ranges) : std::vector<size_type>{ 0u } });
+        }
+    };
+
+    //Runs 'c' at 'range'. The iteration count is grown until a run lasts min_time, which
+    //also serves as warmup, and then the case is repeated to collect the samples.
+    inline bench_result run_case(const bench_case& c, size_type range, const options& opt)
+    {
+        size_type iterations = 1u;
+
+        while (true)
+        {
+            state s(range, iterations);
+            c.func(s);
+
+            const double secs = std::chrono::duration<double>(s.elapsed()).count();
+
+            if (secs >= opt.min_time || iterations >= opt.max_iterations) break;
+
+            double multiplier = (secs > 0.0) ? opt.min_time * 1.4 / secs : 10.0;
+            multiplier = std::clamp(multiplier, 2.0, 10.0);
+
+            iterations = std::min(opt.max_iterations, static_cast<size_type>(static_cast<double>(iterations) * multiplier));
+        }
+
+        std::vector<double> samples;
+        samples.reserve(opt.repetitions);
+
+        for (size_type r = 0u; r < opt.repetitions; r++)
+        {
+            state s(range, iterations);
+            c.func(s);
+
+            const double ns = std::chrono::duration<double, std::nano>(s.elapsed()).count();
+            samples.push_back(ns / static_cast<double>(iterations * s.ops_per_iteration()));
+        }
+
+        bench_result result;
+        result.name = c.name;
+        result.range = range;
+        result.iterations = iterations;
+        result.repetitions = samples.size();
+
+        if (samples.empty()) return result;
+
+        double sum = 0.0;
+        for (double x : samples) sum += x;
+        result.mean = sum / static_cast<double>(samples.size());
+
+        double sq = 0.0;
+        for (double x : samples) sq += (x - result.mean) * (x - result.mean);
+        result.stddev = (samples.size() > 1u) ? std::sqrt(sq / static_cast<double>(samples.size() - 1u)) : 0.0;
+
+        std::sort(samples.begin(), samples.end());
+        const size_type mid = samples.size() / 2u;
+        result.median = (samples.size() % 2u) ? samples[mid] : (samples[mid - 1u] + samples[mid]) / 2.0;
+
+        return result;
+    }
+
+    inline void write_console(std::ostream& out, const std::vector<bench_result>& results)
+    {
+        out << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "mean ns/op"
+            << std::setw(14) << "median ns/op" << std::setw(12) << "stddev" << std::setw(14) << "iterations" << "\n";
+
+        out << std::fixed << std::setprecision(2);
+
+        for (const bench_result& r : results)
+        {
+            const std::string label = r.name + "/" + std::to_string(r.range);
+
+            out << std::left << std::setw(40) << label << std::right << std::setw(12) << r.mean
+                << std::setw(14) << r.median << std::setw(12) << r.stddev << std::setw(14) << r.iterations << "\n";
+        }
+    }
+
+    inline void write_json(std::ostream& out, const std::vector<bench_result>& results)
+    {
+        out << "{\n  \"benchmarks\": [\n" << std::setprecision(4) << std::fixed;
+
+        for (size_type i = 0u; i < results.size(); i++)
+        {
+            const bench_result& r = results[i];
+
+            out << "    { \"name\": \"" << r.name << "\", \"range\": " << r.range
+                << ", \"iterations\": " << r.iterations << ", \"repetitions\": " << r.repetitions
+                << ", \"mean_ns\": " << r.mean << ", \"median_ns\": " << r.median
+                << ", \"stddev_ns\": " << r.stddev << " }" << (i + 1u < results.size() ? ",\n" : "\n");
+        }
+
+        out << "  ]\n}\n";
+    }
+
+    inline void write_csv(std::ostream& out, const std::vector<bench_result>& results)
+    {
+        out << "name,range,iterations,repetitions,mean_ns,median_ns,stddev_ns\n" << std::setprecision(4) << std::fixed;
+
+        for (const bench_result& r : results)
+        {
+            out << r.name << "," << r.range << "," << r.iterations << "," << r.repetitions << ","
+                << r.mean << "," << r.median << "," << r.stddev << "\n";
+        }
+    }
+
+    //Reads --filter=, --repetitions=, --min-time=, --format=console|json|csv and --out=.
+    //Returns false if an argument is not recognized.
+    inline bool parse_options(int argc, char** argv, options& opt)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            auto value = [&arg](const char* key) -> const char* {
+                const size_type len = std::strlen(key);
+                return (arg.compare(0u, len, key) == 0) ? arg.c_str() + len : nullptr;
+            };
+
+            if (const char* v = value("--filter=")) opt.filter = v;
+            else if (const char* v = value("--repetitions=")) opt.repetitions = static_cast<size_type>(std::strtoull(v, nullptr, 10));
+            else if (const char* v = value("--min-time=")) opt.min_time = std::strtod(v, nullptr);
+            else if (const char* v = value("--out=")) opt.out = v;
+            else if (const char* v = value("--format="))
+            {
+                const std::string f = v;
+
+                if (f == "console") opt.format = output_format::console;
+                else if (f == "json") opt.format = output_format::json;
+                else if (f == "csv") opt.format = output_format::csv;
+                else return false;
+            }
+            else return false;
+        }
+
+        return true;
+    }
+
+    //Runs every registered case that matches the options and writes the results.
+    //Returns a process exit code.
+    inline int run(int argc, char** argv)
+    {
+        options opt;
+
+        if (!parse_options(argc, argv, opt))
+        {
+            std::cerr << "usage: " << argv[0]
+                << " [--filter=name] [--repetitions=n] [--min-time=seconds] [--format=console|json|csv] [--out=file]\n";
+            return 1;
+        }
+
+        std::vector<bench_result> results;
+
+        for (const bench_case& c : registry())
+        {
+            if (!opt.filter.empty() && std::string(c.name).find(opt.filter) == std::string::npos) continue;
+
+            for (size_type range : c.ranges)
+                results.push_back(run_case(c, range, opt));
+        }
+
+        std::ofstream file;
+        if (!opt.out.empty())
+        {
+            file.open(opt.out);
+
+            if (!file)
+            {
+                std::cerr << "could not open " << opt.out << "\n";
+                return 1;
+            }
+        }
+
+        std::ostream& out = opt.out.empty() ? std::cout : file;
+
+        switch (opt.format)
+        {
+        case output_format::console: write_console(out, results); break;
+        case output_format::json: write_json(out, results); break;
+        case output_format::csv: write_csv(out, results); break;
+        }
+
+        return 0;
+    }
+
+} // namespace aggro::bench
+
+#define AGGRO_BENCH_CONCAT_(a, b) a##b
+#define AGGRO_BENCH_CONCAT(a, b) AGGRO_BENCH_CONCAT_(a, b)
+
+/*
+    Registers 'func' to run once for every range given after it, e.g.
+    AGGRO_BENCHMARK(test_darray_push_back, 256, 4096, 65536)
+*/
+#define AGGRO_BENCHMARK(func, ...) \
+static const aggro::bench::registrar AGGRO_BENCH_CONCAT(aggro_bench_registrar_, __LINE__)(#func, func, { __VA_ARGS__ });
+
+#endif // AGGRO_BENCH_HPP
@@ -17,6 +17,40 @@ namespace aggro
     template<typename T>
     concept standard_allocator = allocator<T> && requires (T type) { { type.resource() } -> pointer; };
 
+    //Allocators that can sometimes grow a buffer without moving it.
+    //expand() returns false when the buffer has to be reallocated instead.
+    template<typename T>
+    concept expandable_allocator = standard_allocator<T> && requires (T type, std::size_t size)
+    {
+        { type.expand(type.resource(), size, size) } -> same<bool>;
+    };
+
+    //Allocators that keep a fixed number of elements in a buffer of their own before spilling to the heap.
+    template<typename T>
+    concept inline_allocator = standard_allocator<T> && requires (T type)
+    {
+        { T::inline_capacity } -> convertible<std::size_t>;
+        { type.is_inline(type.resource()) } -> same<bool>;
+    };
+
+    /*
+        Node allocators that can hand out several nodes in one call, any of which can later be deallocated on
+        its own. Lists build whole runs of nodes this way, laid out in traversal order. std_node_allocator
+        is not one, since operator delete cannot free part of a block.
+    */
+    template<typename T>
+    concept batch_allocator = standard_allocator<T> && requires (T type, std::size_t size)
+    {
+        { type.allocate_batch(size) } -> same<typename T::memory_resource>;
+    };
+
+    //Allocators that want to be told when a container grows its buffer on its own, as opposed to an explicit reserve().
+    template<typename T>
+    concept growth_tracking_allocator = standard_allocator<T> && requires (T type)
+    {
+        { type.record_grow() };
+    };
+
 } // namespace aggro
 
 #endif // ALLOCCONCEPTS_HPP
\ No newline at end of file
@@ -1,13 +1,18 @@
 #ifndef OBJECTLIFE_HPP
 #define OBJECTLIFE_HPP
 
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace aggro
 {
     template<typename T, typename U>
     concept same = std::is_same_v<T, U>;
 
+    template<typename T, typename U>
+    concept convertible = std::is_convertible_v<T, U>;
+
     template<typename T, typename U>
     concept fully_comparable = requires(T t, U u)
     {
@@ -23,20 +28,31 @@ namespace aggro
     concept pointer = std::is_pointer_v<T>;
 
     template<typename T>
-    concept data_iterator = fully_comparable<T,T> && (pointer<T> || requires (T it, size_t i) {
-        { ++it } -> data_iterator;
-        { it++ } -> data_iterator;
-        { --it } -> data_iterator;
-        { it-- } -> data_iterator;
-        { it + i } -> data_iterator;
-        { it - i } -> data_iterator;
-        { it += i } -> data_iterator;
-        { it -= i } -> data_iterator;
+    concept data_iterator = fully_comparable<T,T> && (pointer<T> || requires (T it, std::size_t i) {
+        { ++it } -> convertible<T>;
+        { it++ } -> convertible<T>;
+        { --it } -> convertible<T>;
+        { it-- } -> convertible<T>;
+        { it + i } -> convertible<T>;
+        { it - i } -> convertible<T>;
+        { it += i } -> convertible<T>;
+        { it -= i } -> convertible<T>;
     });
     
     template<typename T>
     concept destructible = std::is_destructible_v<T>;
 
+    /*
+        Marks types whose objects can be moved to a new address with a plain memcpy, leaving nothing behind
+        that needs destroying. Trivially copyable types qualify automatically. Other types can opt in by
+        specializing this struct to inherit from std::true_type.
+    */
+    template<typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template<typename T>
+    concept trivially_relocatable = is_trivially_relocatable<T>::value;
+
     template<typename T>
     concept default_constructible = std::is_default_constructible_v<T>;
 
@@ -60,6 +76,26 @@ namespace aggro
     template<typename T> 
     concept iterator_disabled = !iterator_enabled<T>;
 
+    //Anything that can be walked from begin() to end() and knows its length up front, such as any of our containers.
+    template<typename T>
+    concept sized_range = requires (T& type)
+    {
+        type.begin() != type.end();
+        { type.size() } -> convertible<std::size_t>;
+    };
+
+    //Containers with contiguous storage, such as darray and array.
+    template<typename T>
+    concept contiguous_container = requires (T& type)
+    {
+        { type.data() } -> pointer;
+        { type.size() } -> convertible<std::size_t>;
+    };
+
+    //Element type of a contiguous_container.
+    template<contiguous_container Container>
+    using container_value_t = std::remove_cvref_t<decltype(*std::declval<Container&>().data())>;
+
 } // namespace aggro
 
 
@@ -1,139 +1,89 @@
 #ifndef AGGRO_DEQUE_HPP
 #define AGGRO_DEQUE_HPP
 
-#include "list.hpp"
-#include "array.hpp"
+#include "utility.hpp"
+#include "optional.hpp"
+#include "concepts/stream.hpp"
+#include "allocators/standard.hpp"
 
 namespace aggro
 {
+    template<typename T, std::size_t Size, standard_allocator Alloc>
+    class deque;
+
+    //Random access iterator for a deque. Holds the position as an index, so jumping around is O(1).
     template<typename T, std::size_t Size, standard_allocator Alloc>
     struct deque_iterator
     {
         using value_type = T;
         using size_type = std::size_t;
-        using node = dlist<array<T, Size>, Alloc>::d_node;
+        using difference_type = std::ptrdiff_t;
+        using container = deque<T, Size, Alloc>;
 
-        node* book = nullptr;
+        container* owner = nullptr;
         size_type index = 0u;
 
-        deque_iterator(node* bk) : book(bk) {}
-        deque_iterator(node* bk, size_type i) : book(bk), index(i) {}
-        deque_iterator(const deque_iterator& other) : book(other.book), index(other.index)
-
-        //Get the underlying pointer.
-        constexpr node* get() const { return book; }
-
         constexpr T& operator*()
         {
-            return book->value[index];
+            return (*owner)[index];
         }
 
         constexpr const T& operator*() const
         {
-            return book->value[index];
+            return (*owner)[index];
         }
 
-        constexpr deque_iterator operator+(size_type ind)
+        constexpr deque_iterator operator+(size_type ind) const
         {
-            while (book && ind > Size - 1u)
-            {
-                book = book->next;
-                ind -= Size;
-            }
-
-            if (book) index = ind;
-
-            return *this;
+            return deque_iterator{ owner, index + ind };
         }
 
-        constexpr deque_iterator operator-(size_type ind)
+        constexpr deque_iterator operator-(size_type ind) const
         {
-            while (book && ind > Size - 1u)
-            {
-                book = book->prev;
-                ind -= Size;
-            }
-
-            if (book) index = Size - ind;
+            return deque_iterator{ owner, index - ind };
+        }
 
-            return *this;
+        //Distance between two iterators of the same deque.
+        constexpr difference_type operator-(const deque_iterator& other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
         }
 
         constexpr deque_iterator& operator+=(size_type ind)
         {
-            while (book && ind > Size - 1u)
-            {
-                book = book->next;
-                ind -= Size;
-            }
-
-            if (book) index = ind;
-
+            index += ind;
             return *this;
         }
 
         constexpr deque_iterator& operator-=(size_type ind)
         {
-            while (book && ind > Size - 1u)
-            {
-                book = book->prev;
-                ind -= Size;
-            }
-
-            if (book) index = Size - ind;
-
+            index -= ind;
             return *this;
         }
 
         constexpr deque_iterator& operator++() //prefix
         {
             ++index;
-            if (index == Size)
-            {
-                book = book->next;
-                index = 0u;
-            }
-
             return *this;
         }
 
-        constexpr deque_iterator& operator++(int) //postfix
+        constexpr deque_iterator operator++(int) //postfix
         {
             deque_iterator temp = *this;
-            
             ++index;
-            if (index == Size)
-            {
-                book = book->next;
-                index = 0u;
-            }
-
             return temp;
         }
 
         constexpr deque_iterator& operator--() //prefix
         {
             --index;
-            if (index == 0u)
-            {
-                book = book->prev;
-                index = Size - 1u;;
-            }
-
             return *this;
         }
 
-        constexpr deque_iterator& operator--(int) //postfix
+        constexpr deque_iterator operator--(int) //postfix
         {
             deque_iterator temp = *this;
-            
             --index;
-            if (index == 0u)
-            {
-                book = book->prev;
-                index = Size - 1u;;
-            }
-
             return temp;
         }
     };
@@ -141,7 +91,7 @@ namespace aggro
     template<typename T, std::size_t Size, standard_allocator Alloc>
     inline constexpr bool operator==(const deque_iterator<T, Size, Alloc>& lhs, const deque_iterator<T, Size, Alloc>& rhs)
     {
-        if (lhs.book == rhs.book && lhs.index == rhs.index)
+        if (lhs.owner == rhs.owner && lhs.index == rhs.index)
         {
             return true;
         }
@@ -151,16 +101,23 @@ namespace aggro
     template<typename T, std::size_t Size, standard_allocator Alloc>
     inline constexpr bool operator!=(const deque_iterator<T, Size, Alloc>& lhs, const deque_iterator<T, Size, Alloc>& rhs)
     {
-        if (lhs.book != rhs.book || lhs.index != rhs.index)
+        if (lhs.owner != rhs.owner || lhs.index != rhs.index)
         {
             return true;
         }
         return false;
     }
-    
-    template<typename T, std::size_t Size, standard_allocator Alloc = std_node_allocator<T>>
+
+    /*
+        A double-ended queue used to replace std::deque. Elements live in fixed blocks of 'Size' elements that
+        are allocated through Alloc and never move once constructed. The blocks are tracked by a circular map of
+        block pointers, so random access is O(1) and both ends can grow in amortized O(1).
+    */
+    template<typename T, std::size_t Size, standard_allocator Alloc = std_contiguous_allocator<T>>
     class deque
-    {   
+    {
+        static_assert(Size > 0u, "A deque block must hold at least one element.");
+
     public:
 
         using size_type = std::size_t;
@@ -174,135 +131,164 @@ namespace aggro
 
 		using iterator = deque_iterator<T, Size, Alloc>;
         using const_iterator = const deque_iterator<T, Size, Alloc>;
-        using reverse_iterator = deque_iterator<T, Size, Alloc>;
-        using const_reverse_iterator = const deque_iterator<T, Size, Alloc>;
 
         using allocator_type = Alloc;
 
     private:
 
-        dlist<array<T, Size>, Alloc> ledger;
+        static constexpr size_type min_map_size = 8u;
+
+        allocator_type alloc;
+        std_contiguous_allocator<pointer> map_alloc;
+
+        pointer* m_map = nullptr;    //Circular array of block pointers. Its size is always a power of two.
+        size_type m_map_size = 0u;
+        size_type m_head = 0u;       //Map slot of the first block.
+        size_type m_blocks = 0u;     //Number of blocks currently allocated.
+        size_type m_offset = 0u;     //Position of the first element inside the first block.
         size_type m_count = 0u;
-        size_type offset = 0u;
+
+        //Block pointer 'n' blocks after the first one.
+        constexpr pointer& block(size_type n) const
+        {
+            return m_map[(m_head + n) & (m_map_size - 1u)];
+        }
+
+        //Address of the element at 'index'.
+        constexpr pointer locate(size_type index) const
+        {
+            index += m_offset;
+            return block(index / Size) + index % Size;
+        }
+
+        //Doubles the map, laying the blocks out from slot 0.
+        constexpr void grow_map()
+        {
+            const size_type nSize = (m_map_size > 0u) ? m_map_size * 2u : min_map_size;
+            pointer* nMap = map_alloc.allocate(nSize);
+
+            for (size_type i = 0; i < m_blocks; i++)
+                nMap[i] = block(i);
+
+            map_alloc.deallocate(m_map, m_map_size);
+
+            m_map = nMap;
+            m_map_size = nSize;
+            m_head = 0u;
+        }
 
         template<typename... Args>
         constexpr void _emplace(pointer spot, Args&&... args)
         {
-            ledger.get_allocator()->construct(spot, forward<Args>(args)...);
+            alloc.construct(spot, aggro::forward<Args>(args)...);
             ++m_count;
         }
 
-        friend static size_type get_offset(const deque& o) { return o.offset; }
-        friend static const dlist<array<T, Size>>& get_ledger(const deque& o) { return o.ledger; }
-        friend static dlist<array<T, Size>>&& get_ledger(deque&& o) { return forward<dlist<array>T, Size>&&(o.ledger); }
+        //Releases every element, block and the map itself.
+        constexpr void release()
+        {
+            clear();
+            map_alloc.deallocate(m_map, m_map_size);
+
+            m_map = nullptr;
+            m_map_size = 0u;
+        }
+
+        //Takes over the map and blocks of another deque, leaving it empty.
+        constexpr void take_map(deque& other)
+        {
+            m_map = other.m_map;
+            m_map_size = other.m_map_size;
+            m_head = other.m_head;
+            m_blocks = other.m_blocks;
+            m_offset = other.m_offset;
+            m_count = other.m_count;
+
+            other.m_map = nullptr;
+            other.m_map_size = 0u;
+            other.m_head = 0u;
+            other.m_blocks = 0u;
+            other.m_offset = 0u;
+            other.m_count = 0u;
+        }
 
     public:
 
         constexpr deque() = default;
-        constexpr ~deque() { clear(); }
+        constexpr ~deque() { release(); }
 
         constexpr deque(const deque& other)
-            : ledger(get_ledger(other)), m_count(other.size()), offset(get_offset(other)) 
-        {}
+        {
+            for (size_type i = 0; i < other.size(); i++)
+                emplace_back(other[i]);
+        }
 
         constexpr deque(deque&& other) noexcept
-            : ledger(move(get_ledger(move(other)))), m_count(other.size()), offset(get_offset(other))
-        {}
+        {
+            take_map(other);
+        }
 
-        constexpr reference operator[](size_type index)
+        constexpr deque& operator=(const deque& other)
         {
-            index += offset;
-            if (index < Size)
-            {
-                return ledger.front()[index];
-            }
-            else
+            if (this != &other)
             {
-                const size_type jumps = index / Size;
-                const size_type steps = index % Size;
+                clear();
 
-                return *((ledger.begin() + jumps).data() + steps);
+                for (size_type i = 0; i < other.size(); i++)
+                    emplace_back(other[i]);
             }
+
+            return *this;
         }
 
-        constexpr const_reference operator[](size_type index) const
+        constexpr deque& operator=(deque&& other) noexcept
         {
-            index += offset;
-            if (index < Size)
+            if (this != &other)
             {
-                return ledger.front()[index];
+                release();
+                take_map(other);
             }
-            else
-            {
-                const size_type jumps = index / Size;
-                const size_type steps = index % Size;
 
-                return *((ledger.begin() + jumps).data() + steps);
-            }
+            return *this;
         }
 
-        constexpr aggro::optional_ref<T> at(size_type index)
-        {            
-            if(index < m_count)
-            {
-                index += offset;
-                if (index < Size)
-                {
-                    return ledger.front()[index];
-                }
-                else
-                {
-                    const size_type jumps = index / Size;
-                    const size_type steps = index % Size;
-
-                    return *((ledger.begin() + jumps).data() + steps);
-                }
-            }
-            else
-            {
-                return aggro::nullopt_ref_t{};
-            }
+        constexpr reference operator[](size_type index)
+        {
+            return *locate(index);
+        }
+
+        constexpr const_reference operator[](size_type index) const
+        {
+            return *locate(index);
         }
 
-        constexpr const aggro::optional_ref<T> at(size_type index) const
+        //Returns an optional reference to the object at 'index' location
+		//provided that the value is within bounds.
+        constexpr aggro::optional_ref<T> at(size_type index) const
         {
             if (index < m_count)
-            {
-                index += offset;
-                if (index < Size)
-                {
-                    return ledger.front()[index];
-                }
-                else
-                {
-                    const size_type jumps = index / Size;
-                    const size_type steps = index % Size;
-
-                    return *((ledger.begin() + jumps).data() + steps);
-                }
-            }
+                return *locate(index);
             else
-            {
-                return aggro::nullopt_ref_t{};
-            }
+                return aggro::nullopt_ref_t<T>();
         }
 
         template<typename... Args>
         constexpr iterator emplace_front(Args&&... args)
         {
-            if (offset == 0u)
+            if (m_offset == 0u)
             {
-                ledger.emplace_front();
-                offset = Size - 1u;
-                _emplace(&(ledger.front()[offset]), forward<Args>(args)...);
-            }
-            else
-            {
-                --offset;
-                _emplace(&(ledger.front()[offset]), forward<Args>(args)...);
+                if (m_blocks == m_map_size) grow_map();
+
+                m_head = (m_head - 1u) & (m_map_size - 1u);
+                block(0u) = alloc.allocate(Size);
+                ++m_blocks;
+                m_offset = Size;
             }
 
-            return iterator{ ledger.begin().get(), offset };
+            --m_offset;
+            _emplace(block(0u) + m_offset, aggro::forward<Args>(args)...);
+
+            return iterator{ this, 0u };
         }
 
         constexpr iterator push_front(const T& elem) { return emplace_front(elem); }
@@ -311,14 +297,19 @@ namespace aggro
         template<typename... Args>
         constexpr iterator emplace_back(Args&&... args)
         {
-            if (empty()) return emplace_front(forward<Args>(args)...);
+            const size_type loc = m_offset + m_count;
 
-            const size_type loc = (offset + m_count) % Size;
+            if (loc == m_blocks * Size)
+            {
+                if (m_blocks == m_map_size) grow_map();
+
+                block(m_blocks) = alloc.allocate(Size);
+                ++m_blocks;
+            }
 
-            if (loc == 0u) ledger.emplace_back();
-            _emplace((ledger.back()[loc]), forward<Args>(args)...);
+            _emplace(block(loc / Size) + loc % Size, aggro::forward<Args>(args)...);
 
-            return iterator{ get_allocator()->resource_rev(), loc };
+            return iterator{ this, m_count - 1u };
         }
 
         constexpr iterator push_back(const T& elem) { return emplace_back(elem); }
@@ -328,64 +319,91 @@ namespace aggro
         {
             if (empty()) return;
 
-            if (offset == Size - 1u)
-            {
-                offset = 0u;
-                ledger.pop_front();
-            }
-            else
+            front().~T();
+            ++m_offset;
+            --m_count;
+
+            if (m_offset == Size)
             {
-                ledger.front()[offset].~T();
-                ++offset;
+                alloc.deallocate(block(0u), Size);
+                m_head = (m_head + 1u) & (m_map_size - 1u);
+                --m_blocks;
+                m_offset = 0u;
             }
-
-            --m_count;
         }
 
         constexpr void pop_back()
         {
             if (empty()) return;
 
-            const size_type loc = (offset + m_count) % Size;
+            back().~T();
+            --m_count;
 
-            if (loc == 0u)
+            if (m_blocks * Size - (m_offset + m_count) >= Size)
             {
-                ledger.pop_back();
+                --m_blocks;
+                alloc.deallocate(block(m_blocks), Size);
             }
-            else
-            {
-                ledger.back()[loc].~T();
-            }
-
-            --m_count;
         }
 
-        constexpr allocator_type* get_allocator() const noexcept { return ledger.get_allocator(); }
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+
         constexpr size_type size() const { return m_count; }
 
-        [[nodiscard("Function does not empty the container.")]] constexpr bool empty() const { return begin() == end(); }
+        [[nodiscard("Function does not empty the container.")]] constexpr bool empty() const { return m_count == 0u; }
 
+        //Destroys every element and frees the blocks. The block map is kept for reuse.
         constexpr void clear()
         {
-            ledger.clear();
-            offset = 0u;
+            for (size_type i = 0; i < m_count; i++)
+                locate(i)->~T();
+
+            for (size_type i = 0; i < m_blocks; i++)
+                alloc.deallocate(block(i), Size);
+
+            m_head = 0u;
+            m_blocks = 0u;
+            m_offset = 0u;
             m_count = 0u;
         }
 
-        constexpr reference front() { return ledger.front()[offset]; }
-        constexpr const_reference front() const { return ledger.front()[offset]; }
+        constexpr reference front() { return *locate(0u); }
+        constexpr const_reference front() const { return *locate(0u); }
+
+        constexpr reference back() { return *locate(m_count - 1u); }
+        constexpr const_reference back() const { return *locate(m_count - 1u); }
 
-        constexpr reference back() { return ledger.back()[(m_count - offset) % Size]; }
-        constexpr const_reference back() const { return ledger.back()[(m_count - offset) % Size]; }
-        
-        constexpr iterator begin() { return iterator{ ledger.begin()) }; }
-        constexpr const_iterator begin() const { return const_iterator{ ledger.begin() }; }
+        constexpr iterator begin() { return iterator{ this, 0u }; }
+        constexpr const_iterator begin() const { return const_iterator{ const_cast<deque*>(this), 0u }; }
 
-        constexpr iterator end() { return iterator{ nullptr }; }
-        constexpr const_iterator end() const { return const_iterator{ nullptr }; }
+        constexpr iterator end() { return iterator{ this, m_count }; }
+        constexpr const_iterator end() const { return const_iterator{ const_cast<deque*>(this), m_count }; }
     };
 
+    template<os_compatible T, std::size_t Size, standard_allocator Alloc>
+    inline constexpr std::ostream& operator<<(std::ostream& stream, const deque<T, Size, Alloc>& obj)
+    {
+        stream << "{ ";
+
+        if(obj.size() > 0)
+        {
+            auto size = obj.size() - 1;
+
+            for(size_t ind = 0; ind < size; ++ind)
+                stream << obj[ind] << ", ";
+
+            stream << obj[size];
+        }
+            stream  << " }";
+
+        return stream;
+    }
+
 } // namespace aggro
 
 
-#endif // AGGRO_DEQUE_HPP
\ No newline at end of file
+#endif // AGGRO_DEQUE_HPP
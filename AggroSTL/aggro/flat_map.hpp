@@ -0,0 +1,453 @@
+#ifndef AGGRO_FLAT_MAP_HPP
+#define AGGRO_FLAT_MAP_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include "array.hpp"
+
+namespace aggro
+{
+    //A key and its value as seen through a flat_map iterator.
+    template<typename K, typename V>
+    struct flat_map_ref
+    {
+        const K& first;
+        V& second;
+    };
+
+    //Random access iterator for a flat_map. Walks the key and value arrays side by side.
+    template<typename K, typename V>
+    struct flat_map_iterator
+    {
+        using value_type = flat_map_ref<K, V>;
+        using size_type = std::size_t;
+
+        const K* key = nullptr;
+        V* value = nullptr;
+
+        constexpr value_type operator*() const { return value_type{ *key, *value }; }
+
+        constexpr flat_map_iterator operator+(size_type index) const { return flat_map_iterator{ key + index, value + index }; }
+        constexpr flat_map_iterator operator-(size_type index) const { return flat_map_iterator{ key - index, value - index }; }
+
+        constexpr flat_map_iterator& operator+=(size_type index)
+        {
+            key += index;
+            value += index;
+            return *this;
+        }
+
+        constexpr flat_map_iterator& operator-=(size_type index)
+        {
+            key -= index;
+            value -= index;
+            return *this;
+        }
+
+        constexpr flat_map_iterator& operator++() //prefix
+        {
+            ++key;
+            ++value;
+            return *this;
+        }
+
+        constexpr flat_map_iterator operator++(int) //postfix
+        {
+            flat_map_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        constexpr flat_map_iterator& operator--() //prefix
+        {
+            --key;
+            --value;
+            return *this;
+        }
+
+        constexpr flat_map_iterator operator--(int) //postfix
+        {
+            flat_map_iterator old = *this;
+            --(*this);
+            return old;
+        }
+    };
+
+    template<typename K, typename V>
+    inline constexpr bool operator==(const flat_map_iterator<K, V>& lhs, const flat_map_iterator<K, V>& rhs)
+    {
+        return lhs.key == rhs.key;
+    }
+
+    template<typename K, typename V>
+    inline constexpr bool operator!=(const flat_map_iterator<K, V>& lhs, const flat_map_iterator<K, V>& rhs)
+    {
+        return lhs.key != rhs.key;
+    }
+
+    /*
+        A sorted associative container for read-mostly lookup tables. Keys and values are kept in two parallel
+        darrays sorted by key, so lookups are a binary search over a contiguous array of keys and there is no
+        per-entry node overhead. Inserting a single entry is O(n); use insert_range to add many entries with
+        one sort and one merge.
+    */
+    template<typename K, typename V, typename Compare = std::less<K>,
+        standard_allocator KeyAlloc = std_contiguous_allocator<K>, standard_allocator ValueAlloc = std_contiguous_allocator<V>>
+    class flat_map
+    {
+    public:
+        using size_type = std::size_t;
+        using key_type = K;
+        using mapped_type = V;
+
+        using iterator = flat_map_iterator<K, V>;
+        using const_iterator = flat_map_iterator<K, const V>;
+
+        using key_container = darray<K, KeyAlloc>;
+        using value_container = darray<V, ValueAlloc>;
+
+    private:
+        key_container m_keys;
+        value_container m_values;
+        [[no_unique_address]] Compare m_less;
+
+        //Index of the first key that is not less than 'key'.
+        constexpr size_type lower_bound(const K& key) const
+        {
+            return static_cast<size_type>(std::lower_bound(m_keys.begin(), m_keys.end(), key, m_less) - m_keys.begin());
+        }
+
+        //Index of 'key', or size() if it is not present.
+        constexpr size_type index_of(const K& key) const
+        {
+            const size_type index = lower_bound(key);
+
+            if (index < m_keys.size() && !m_less(key, m_keys[index])) return index;
+
+            return m_keys.size();
+        }
+
+        //Moves the last element of 'arr' down to 'index', shifting the elements in between up by one.
+        template<typename T, typename A>
+        static constexpr void sink_last(darray<T, A>& arr, size_type index)
+        {
+            for (size_type i = arr.size() - 1u; i > index; i--)
+            {
+                T temp = move(arr[i]);
+                arr[i] = move(arr[i - 1u]);
+                arr[i - 1u] = move(temp);
+            }
+        }
+
+        template<typename Key, typename... Args>
+        constexpr V& insert_at(size_type index, Key&& key, Args&&... args)
+        {
+            m_keys.emplace_back(aggro::forward<Key>(key));
+            m_values.emplace_back(aggro::forward<Args>(args)...);
+
+            sink_last(m_keys, index);
+            sink_last(m_values, index);
+
+            return m_values[index];
+        }
+
+    public:
+        constexpr flat_map() = default;
+
+        constexpr flat_map(std::initializer_list<map_entry<K, V>> inits)
+        {
+            insert_range(inits.begin(), inits.end());
+        }
+
+        //Returns an optional reference to the value stored under 'key'.
+        constexpr aggro::optional_ref<V> find(const K& key)
+        {
+            const size_type index = index_of(key);
+
+            if (index != m_keys.size())
+                return m_values[index];
+            else
+                return aggro::nullopt_ref_t<V>();
+        }
+
+        //Returns an optional reference to the value stored under 'key'.
+        constexpr aggro::optional_ref<const V> find(const K& key) const
+        {
+            const size_type index = index_of(key);
+
+            if (index != m_keys.size())
+                return m_values[index];
+            else
+                return aggro::nullopt_ref_t<const V>();
+        }
+
+        constexpr bool contains(const K& key) const { return index_of(key) != m_keys.size(); }
+
+        //Inserts the pair if the key is not present yet. Returns false if the key already existed.
+        constexpr bool insert(const K& key, const V& value)
+        {
+            const size_type index = lower_bound(key);
+
+            if (index < m_keys.size() && !m_less(key, m_keys[index])) return false;
+
+            insert_at(index, key, value);
+            return true;
+        }
+
+        //Constructs the value in place if the key is not present yet and returns the stored value either way.
+        template<typename... Args>
+        constexpr V& try_emplace(const K& key, Args&&... args)
+        {
+            const size_type index = lower_bound(key);
+
+            if (index < m_keys.size() && !m_less(key, m_keys[index])) return m_values[index];
+
+            return insert_at(index, key, aggro::forward<Args>(args)...);
+        }
+
+        //Returns the value stored under 'key', default constructing it first if needed.
+        constexpr V& operator[](const K& key) { return try_emplace(key); }
+
+        /*
+            Inserts every pair in [first, last) that has a key not already in the map. The new pairs are sorted
+            once and merged with the existing entries in a single pass, instead of being inserted one by one.
+            Entries already in the map win over new ones, and among new pairs with equal keys the first wins.
+            The iterators must dereference to something with 'first' and 'second' members.
+        */
+        template<typename InputIt>
+        constexpr void insert_range(InputIt first, InputIt last)
+        {
+            darray<K> new_keys;
+            darray<V> new_values;
+            darray<size_type> order;
+
+            if constexpr (std::forward_iterator<InputIt>)
+            {
+                const size_type count = static_cast<size_type>(std::distance(first, last));
+
+                new_keys.reserve(count);
+                new_values.reserve(count);
+                order.reserve(count);
+            }
+
+            for (; first != last; ++first)
+            {
+                new_keys.emplace_back((*first).first);
+                new_values.emplace_back((*first).second);
+                order.emplace_back(order.size());
+            }
+
+            if (order.empty()) return;
+
+            std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+                return m_less(new_keys[a], new_keys[b]);
+            });
+
+            key_container keys(m_keys.size() + order.size());
+            value_container values(m_keys.size() + order.size());
+            size_type old_index = 0u;
+            size_type new_index = 0u;
+
+            while (old_index < m_keys.size() || new_index < order.size())
+            {
+                if (new_index == order.size() ||
+                    (old_index < m_keys.size() && !m_less(new_keys[order[new_index]], m_keys[old_index])))
+                {
+                    //Skip new keys equal to the existing one; the existing entry wins.
+                    while (new_index < order.size() && !m_less(m_keys[old_index], new_keys[order[new_index]]))
+                        ++new_index;
+
+                    keys.emplace_back(move(m_keys[old_index]));
+                    values.emplace_back(move(m_values[old_index]));
+                    ++old_index;
+                }
+                else
+                {
+                    const size_type pick = order[new_index];
+
+                    keys.emplace_back(move(new_keys[pick]));
+                    values.emplace_back(move(new_values[pick]));
+
+                    //Later duplicates of the same new key are dropped.
+                    while (new_index < order.size() && !m_less(keys.back(), new_keys[order[new_index]]))
+                        ++new_index;
+                }
+            }
+
+            m_keys = move(keys);
+            m_values = move(values);
+        }
+
+        //Removes the entry stored under 'key'. Returns false if there was none.
+        constexpr bool erase(const K& key)
+        {
+            const size_type index = index_of(key);
+
+            if (index == m_keys.size()) return false;
+
+            m_keys.erase(m_keys.begin() + index, m_keys.begin() + index + 1u);
+            m_values.erase(m_values.begin() + index, m_values.begin() + index + 1u);
+
+            return true;
+        }
+
+        constexpr void reserve(size_type cap)
+        {
+            if (cap <= m_keys.capacity()) return;
+
+            m_keys.reserve(cap);
+            m_values.reserve(cap);
+        }
+
+        constexpr void clear()
+        {
+            m_keys.clear();
+            m_values.clear();
+        }
+
+        constexpr size_type size() const { return m_keys.size(); }
+
+        [[nodiscard("This function does not empty the map.")]] constexpr bool empty() const { return m_keys.empty(); }
+
+        //The sorted keys.
+        constexpr const key_container& keys() const { return m_keys; }
+
+        //The values, in the same order as keys().
+        constexpr const value_container& values() const { return m_values; }
+
+        constexpr iterator begin() { return iterator{ m_keys.begin(), m_values.begin() }; }
+        constexpr iterator end() { return iterator{ m_keys.end(), m_values.end() }; }
+
+        constexpr const_iterator begin() const { return const_iterator{ m_keys.begin(), m_values.begin() }; }
+        constexpr const_iterator end() const { return const_iterator{ m_keys.end(), m_values.end() }; }
+    };
+
+    /*
+        A sorted set of unique keys kept in one darray, for read-mostly lookups. Lookups are a binary search over
+        contiguous memory. Use insert_range to add many keys with one sort and one merge.
+    */
+    template<typename K, typename Compare = std::less<K>, standard_allocator Alloc = std_contiguous_allocator<K>>
+    class flat_set
+    {
+    public:
+        using size_type = std::size_t;
+        using key_type = K;
+        using value_type = K;
+
+        using iterator = const K*;
+        using const_iterator = const K*;
+
+        using key_container = darray<K, Alloc>;
+
+    private:
+        key_container m_keys;
+        [[no_unique_address]] Compare m_less;
+
+        //Index of the first key that is not less than 'key'.
+        constexpr size_type lower_bound(const K& key) const
+        {
+            return static_cast<size_type>(std::lower_bound(m_keys.begin(), m_keys.end(), key, m_less) - m_keys.begin());
+        }
+
+        constexpr bool equal_at(size_type index, const K& key) const
+        {
+            return index < m_keys.size() && !m_less(key, m_keys[index]);
+        }
+
+    public:
+        constexpr flat_set() = default;
+
+        constexpr flat_set(std::initializer_list<K> inits)
+        {
+            insert_range(inits.begin(), inits.end());
+        }
+
+        //Returns an optional reference to the stored key equal to 'key'.
+        constexpr aggro::optional_ref<const K> find(const K& key) const
+        {
+            const size_type index = lower_bound(key);
+
+            if (equal_at(index, key))
+                return m_keys[index];
+            else
+                return aggro::nullopt_ref_t<const K>();
+        }
+
+        constexpr bool contains(const K& key) const { return equal_at(lower_bound(key), key); }
+
+        //Inserts the key if it is not present yet. Returns false if it already existed.
+        constexpr bool insert(const K& key)
+        {
+            const size_type index = lower_bound(key);
+
+            if (equal_at(index, key)) return false;
+
+            m_keys.emplace_back(key);
+
+            for (size_type i = m_keys.size() - 1u; i > index; i--)
+            {
+                K temp = move(m_keys[i]);
+                m_keys[i] = move(m_keys[i - 1u]);
+                m_keys[i - 1u] = move(temp);
+            }
+
+            return true;
+        }
+
+        //Inserts every key in [first, last) that is not already in the set, with one sort and one merge.
+        template<typename InputIt>
+        constexpr void insert_range(InputIt first, InputIt last)
+        {
+            const size_type old_size = m_keys.size();
+
+            if constexpr (std::forward_iterator<InputIt>)
+                reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+
+            for (; first != last; ++first)
+                m_keys.emplace_back(*first);
+
+            if (m_keys.size() == old_size) return;
+
+            std::sort(m_keys.begin() + old_size, m_keys.end(), m_less);
+            std::inplace_merge(m_keys.begin(), m_keys.begin() + old_size, m_keys.end(), m_less);
+
+            auto equal = [this](const K& a, const K& b) { return !m_less(a, b) && !m_less(b, a); };
+            K* last_unique = std::unique(m_keys.begin(), m_keys.end(), equal);
+
+            m_keys.erase(last_unique);
+        }
+
+        //Removes 'key'. Returns false if it was not present.
+        constexpr bool erase(const K& key)
+        {
+            const size_type index = lower_bound(key);
+
+            if (!equal_at(index, key)) return false;
+
+            m_keys.erase(m_keys.begin() + index, m_keys.begin() + index + 1u);
+            return true;
+        }
+
+        constexpr void reserve(size_type cap)
+        {
+            if (cap > m_keys.capacity()) m_keys.reserve(cap);
+        }
+
+        constexpr void clear() { m_keys.clear(); }
+
+        constexpr size_type size() const { return m_keys.size(); }
+
+        [[nodiscard("This function does not empty the set.")]] constexpr bool empty() const { return m_keys.empty(); }
+
+        //The sorted keys.
+        constexpr const key_container& keys() const { return m_keys; }
+
+        constexpr const_iterator begin() const { return m_keys.begin(); }
+        constexpr const_iterator end() const { return m_keys.end(); }
+    };
+
+} // namespace aggro
+
+#endif // AGGRO_FLAT_MAP_HPP
@@ -0,0 +1,524 @@
+#ifndef AGGRO_HASH_MAP_HPP
+#define AGGRO_HASH_MAP_HPP
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include "utility.hpp"
+#include "optional.hpp"
+#include "allocators/standard.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AGGRO_HASH_SSE2
+#endif
+
+namespace aggro
+{
+    //Control byte values. Full slots store the low 7 bits of their hash instead, which is never negative.
+    namespace hash_ctrl
+    {
+        inline constexpr signed char empty = -128;
+        inline constexpr signed char deleted = -2;
+    }
+
+    /*
+        A group of control bytes that is probed in one go. Uses AVX2 (32 bytes) or SSE2 (16 bytes) when the
+        target supports them, and a portable 8 byte version otherwise. Every match function returns a bitmask
+        with bit i set if byte i matches.
+    */
+#if defined(__AVX2__)
+    struct probe_group
+    {
+        static constexpr std::size_t width = 32u;
+
+        __m256i bytes;
+
+        explicit probe_group(const signed char* pos)
+            : bytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos)))
+        {}
+
+        std::uint32_t match(signed char hash) const
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(hash))));
+        }
+
+        std::uint32_t match_empty() const { return match(hash_ctrl::empty); }
+
+        //Empty and deleted bytes are the only negative ones smaller than -1.
+        std::uint32_t match_free() const
+        {
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(-1), bytes)));
+        }
+    };
+#elif defined(AGGRO_HASH_SSE2)
+    struct probe_group
+    {
+        static constexpr std::size_t width = 16u;
+
+        __m128i bytes;
+
+        explicit probe_group(const signed char* pos)
+            : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos)))
+        {}
+
+        std::uint32_t match(signed char hash) const
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(hash))));
+        }
+
+        std::uint32_t match_empty() const { return match(hash_ctrl::empty); }
+
+        //Empty and deleted bytes are the only negative ones smaller than -1.
+        std::uint32_t match_free() const
+        {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+        }
+    };
+#else
+    struct probe_group
+    {
+        static constexpr std::size_t width = 8u;
+
+        signed char bytes[width];
+
+        explicit probe_group(const signed char* pos)
+        {
+            std::memcpy(bytes, pos, width);
+        }
+
+        std::uint32_t match(signed char hash) const
+        {
+            std::uint32_t mask = 0u;
+
+            for (std::size_t i = 0; i < width; i++)
+                if (bytes[i] == hash) mask |= 1u << i;
+
+            return mask;
+        }
+
+        std::uint32_t match_empty() const { return match(hash_ctrl::empty); }
+
+        std::uint32_t match_free() const
+        {
+            std::uint32_t mask = 0u;
+
+            for (std::size_t i = 0; i < width; i++)
+                if (bytes[i] < -1) mask |= 1u << i;
+
+            return mask;
+        }
+    };
+#endif
+
+    //Forward iterator over the occupied slots of a flat_hash_map.
+    template<typename K, typename V>
+    struct hash_map_iterator
+    {
+        using value_type = map_entry<K, V>;
+        using size_type = std::size_t;
+
+        value_type* slot = nullptr;
+        const signed char* control = nullptr;
+        const signed char* control_end = nullptr;
+
+        //Moves forward to the next full slot, or to the end.
+        constexpr void skip_free()
+        {
+            while (control != control_end && *control < 0)
+            {
+                ++control;
+                ++slot;
+            }
+        }
+
+        constexpr value_type& operator*() const { return *slot; }
+        constexpr value_type* operator->() const { return slot; }
+
+        constexpr hash_map_iterator& operator++() //prefix
+        {
+            ++control;
+            ++slot;
+            skip_free();
+            return *this;
+        }
+
+        constexpr hash_map_iterator operator++(int) //postfix
+        {
+            hash_map_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+    };
+
+    template<typename K, typename V>
+    inline constexpr bool operator==(const hash_map_iterator<K, V>& lhs, const hash_map_iterator<K, V>& rhs)
+    {
+        return lhs.control == rhs.control;
+    }
+
+    template<typename K, typename V>
+    inline constexpr bool operator!=(const hash_map_iterator<K, V>& lhs, const hash_map_iterator<K, V>& rhs)
+    {
+        return lhs.control != rhs.control;
+    }
+
+    /*
+        An open-addressing hash map used in place of std::unordered_map. Entries are stored inline in one flat
+        array, next to an array of one-byte control codes holding 7 bits of each entry's hash. Lookups compare a
+        whole group of control bytes at once with SIMD instructions, so most probes touch one cache line of
+        control bytes and only compare keys that are very likely equal. Slots and control bytes come from a
+        single allocation of Alloc; lookups never allocate. The table grows at 7/8 load.
+    */
+    template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+        standard_allocator Alloc = std_contiguous_allocator<map_entry<K, V>>>
+    class flat_hash_map
+    {
+    public:
+        using size_type = std::size_t;
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = map_entry<K, V>;
+
+        using iterator = hash_map_iterator<K, V>;
+        using const_iterator = const hash_map_iterator<K, V>;
+        using allocator_type = Alloc;
+
+    private:
+        static constexpr size_type group_width = probe_group::width;
+
+        allocator_type alloc;
+        signed char* m_ctrl = nullptr; //Control bytes, followed by a copy of the first group for wrap-around loads.
+        size_type m_capacity = 0u;     //Number of slots. Always zero or a power of two of at least group_width.
+        size_type m_count = 0u;
+        size_type m_deleted = 0u;
+
+        [[no_unique_address]] Hash m_hash;
+        [[no_unique_address]] KeyEqual m_equal;
+
+        //Number of slot-sized units needed to hold the control bytes behind the slots.
+        static constexpr size_type control_units(size_type cap)
+        {
+            return (cap + group_width + sizeof(value_type) - 1u) / sizeof(value_type);
+        }
+
+        //Spreads the user's hash so that both the probe start and the 7 bit tag get well mixed bits.
+        constexpr size_type hash_of(const K& key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(m_hash(key));
+            h ^= h >> 33u;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33u;
+
+            return static_cast<size_type>(h);
+        }
+
+        static constexpr size_type probe_start(size_type hash) { return hash >> 7u; }
+        static constexpr signed char tag(size_type hash) { return static_cast<signed char>(hash & 0x7fu); }
+
+        constexpr value_type* slots() const { return alloc.resource(); }
+
+        constexpr void set_ctrl(size_type index, signed char value)
+        {
+            m_ctrl[index] = value;
+            if (index < group_width) m_ctrl[m_capacity + index] = value;
+        }
+
+        //Slot index of 'key', or m_capacity if it is not in the table.
+        constexpr size_type find_index(const K& key) const
+        {
+            if (m_count == 0u) return m_capacity;
+
+            const size_type hash = hash_of(key);
+            const size_type mask = m_capacity - 1u;
+            size_type pos = probe_start(hash) & mask;
+
+            for (size_type step = group_width; ; step += group_width)
+            {
+                probe_group group(m_ctrl + pos);
+
+                for (std::uint32_t bits = group.match(tag(hash)); bits != 0u; bits &= bits - 1u)
+                {
+                    const size_type index = (pos + static_cast<size_type>(std::countr_zero(bits))) & mask;
+
+                    if (m_equal(slots()[index].first, key)) return index;
+                }
+
+                if (group.match_empty() != 0u) return m_capacity;
+
+                pos = (pos + step) & mask;
+            }
+        }
+
+        //First empty or deleted slot on the probe sequence of 'hash'.
+        constexpr size_type find_free(size_type hash) const
+        {
+            const size_type mask = m_capacity - 1u;
+            size_type pos = probe_start(hash) & mask;
+
+            for (size_type step = group_width; ; step += group_width)
+            {
+                const std::uint32_t bits = probe_group(m_ctrl + pos).match_free();
+
+                if (bits != 0u) return (pos + static_cast<size_type>(std::countr_zero(bits))) & mask;
+
+                pos = (pos + step) & mask;
+            }
+        }
+
+        //Moves every entry into a fresh table of 'cap' slots, dropping tombstones.
+        constexpr void rehash(size_type cap)
+        {
+            value_type* old_slots = slots();
+            signed char* old_ctrl = m_ctrl;
+            const size_type old_cap = m_capacity;
+
+            m_capacity = cap;
+            alloc.set_res(alloc.allocate(cap + control_units(cap)));
+            m_ctrl = reinterpret_cast<signed char*>(slots() + cap);
+            std::memset(m_ctrl, hash_ctrl::empty, cap + group_width);
+            m_deleted = 0u;
+
+            for (size_type i = 0; i < old_cap; i++)
+            {
+                if (old_ctrl[i] < 0) continue;
+
+                const size_type hash = hash_of(old_slots[i].first);
+                const size_type index = find_free(hash);
+
+                alloc.construct(&slots()[index], move(old_slots[i]));
+                set_ctrl(index, tag(hash));
+                old_slots[i].~value_type();
+            }
+
+            if (old_slots) alloc.deallocate(old_slots, old_cap + control_units(old_cap));
+        }
+
+        //Makes sure one more entry fits under the 7/8 load limit.
+        constexpr void prepare_insert()
+        {
+            if (m_capacity == 0u)
+            {
+                rehash(group_width);
+            }
+            else if ((m_count + m_deleted + 1u) * 8u > m_capacity * 7u)
+            {
+                //Mostly tombstones: clean up in place instead of growing.
+                rehash((m_count * 2u < m_capacity) ? m_capacity : m_capacity * 2u);
+            }
+        }
+
+        //Inserts a new entry for 'key' that is known not to be in the table yet.
+        template<typename Key, typename... Args>
+        constexpr value_type& insert_new(Key&& key, Args&&... args)
+        {
+            prepare_insert();
+
+            const size_type hash = hash_of(key);
+            const size_type index = find_free(hash);
+
+            if (m_ctrl[index] == hash_ctrl::deleted) --m_deleted;
+
+            new(&slots()[index]) value_type{ K(aggro::forward<Key>(key)), V(aggro::forward<Args>(args)...) };
+            set_ctrl(index, tag(hash));
+            ++m_count;
+
+            return slots()[index];
+        }
+
+        constexpr void destroy_all()
+        {
+            for (size_type i = 0; i < m_capacity; i++)
+                if (m_ctrl[i] >= 0) slots()[i].~value_type();
+        }
+
+        //Takes over the table of another map, leaving it empty.
+        constexpr void take_table(flat_hash_map& other)
+        {
+            alloc.set_res(other.alloc.resource());
+            m_ctrl = other.m_ctrl;
+            m_capacity = other.m_capacity;
+            m_count = other.m_count;
+            m_deleted = other.m_deleted;
+
+            other.alloc.set_res(nullptr);
+            other.m_ctrl = nullptr;
+            other.m_capacity = 0u;
+            other.m_count = 0u;
+            other.m_deleted = 0u;
+        }
+
+        constexpr void release()
+        {
+            destroy_all();
+            if (slots()) alloc.deallocate(slots(), m_capacity + control_units(m_capacity));
+        }
+
+        constexpr void copy_from(const flat_hash_map& other)
+        {
+            if (other.m_count == 0u) return;
+
+            rehash(other.m_capacity);
+
+            for (const auto& entry : other)
+                insert_new(entry.first, entry.second);
+        }
+
+    public:
+
+        constexpr flat_hash_map() = default;
+
+        constexpr flat_hash_map(std::initializer_list<value_type> inits)
+        {
+            reserve(inits.size());
+
+            for (const auto& entry : inits)
+                insert(entry.first, entry.second);
+        }
+
+        constexpr flat_hash_map(const flat_hash_map& other)
+        {
+            copy_from(other);
+        }
+
+        constexpr flat_hash_map(flat_hash_map&& other) noexcept
+        {
+            take_table(other);
+        }
+
+        constexpr flat_hash_map& operator=(const flat_hash_map& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_from(other);
+            }
+
+            return *this;
+        }
+
+        constexpr flat_hash_map& operator=(flat_hash_map&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                take_table(other);
+            }
+
+            return *this;
+        }
+
+        constexpr ~flat_hash_map() { release(); }
+
+        //Returns an optional reference to the value stored under 'key'.
+        constexpr aggro::optional_ref<V> find(const K& key) const
+        {
+            const size_type index = find_index(key);
+
+            if (index != m_capacity)
+                return slots()[index].second;
+            else
+                return aggro::nullopt_ref_t<V>();
+        }
+
+        constexpr bool contains(const K& key) const { return find_index(key) != m_capacity; }
+
+        //Copies the pair in if the key is not present yet. Returns false if the key already existed.
+        constexpr bool insert(const K& key, const V& value)
+        {
+            if (find_index(key) != m_capacity) return false;
+
+            insert_new(key, value);
+            return true;
+        }
+
+        //Moves the pair in if the key is not present yet. Returns false if the key already existed.
+        constexpr bool insert(K&& key, V&& value)
+        {
+            if (find_index(key) != m_capacity) return false;
+
+            insert_new(move(key), move(value));
+            return true;
+        }
+
+        //Constructs the value in place if the key is not present yet and returns the stored value either way.
+        template<typename... Args>
+        constexpr V& try_emplace(const K& key, Args&&... args)
+        {
+            const size_type index = find_index(key);
+
+            if (index != m_capacity) return slots()[index].second;
+
+            return insert_new(key, aggro::forward<Args>(args)...).second;
+        }
+
+        //Returns the value stored under 'key', default constructing it first if needed.
+        constexpr V& operator[](const K& key) { return try_emplace(key); }
+
+        //Removes the entry stored under 'key'. Returns false if there was none.
+        constexpr bool erase(const K& key)
+        {
+            const size_type index = find_index(key);
+
+            if (index == m_capacity) return false;
+
+            slots()[index].~value_type();
+            set_ctrl(index, hash_ctrl::deleted);
+            --m_count;
+            ++m_deleted;
+
+            return true;
+        }
+
+        //Makes room for 'count' entries without further rehashing.
+        constexpr void reserve(size_type count)
+        {
+            size_type cap = group_width;
+            while (cap * 7u < count * 8u) cap *= 2u;
+
+            if (cap > m_capacity) rehash(cap);
+        }
+
+        //Removes every entry but keeps the table.
+        constexpr void clear()
+        {
+            destroy_all();
+
+            if (m_ctrl) std::memset(m_ctrl, hash_ctrl::empty, m_capacity + group_width);
+
+            m_count = 0u;
+            m_deleted = 0u;
+        }
+
+        constexpr size_type size() const { return m_count; }
+        constexpr size_type capacity() const { return m_capacity; }
+
+        [[nodiscard("This function does not empty the map.")]] constexpr bool empty() const { return m_count == 0u; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+
+        constexpr iterator begin() const
+        {
+            iterator it{ slots(), m_ctrl, m_ctrl + m_capacity };
+            it.skip_free();
+            return it;
+        }
+
+        constexpr iterator end() const { return iterator{ slots() + m_capacity, m_ctrl + m_capacity, m_ctrl + m_capacity }; }
+    };
+
+} // namespace aggro
+
+#ifdef AGGRO_HASH_SSE2
+#undef AGGRO_HASH_SSE2
+#endif
+
+#endif // AGGRO_HASH_MAP_HPP
@@ -0,0 +1,685 @@
+#ifndef AGGRO_INTRUSIVE_LIST_HPP
+#define AGGRO_INTRUSIVE_LIST_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include "utility.hpp"
+#include "concepts/stream.hpp"
+
+namespace aggro
+{
+    /*
+        Hook embedded in objects that can be linked into an intrusive_slist. Copying an object does not copy
+        its place in a list, so a copied hook always starts unlinked.
+    */
+    struct islist_hook
+    {
+        islist_hook* next = nullptr;
+
+        constexpr islist_hook() = default;
+        constexpr islist_hook(const islist_hook&) {}
+        constexpr islist_hook& operator=(const islist_hook&) { return *this; }
+
+        //Is the owning object currently in a list?
+        constexpr bool is_linked() const { return next != nullptr; }
+    };
+
+    /*
+        Hook embedded in objects that can be linked into an intrusive_dlist. Copying an object does not copy
+        its place in a list, so a copied hook always starts unlinked.
+    */
+    struct idlist_hook
+    {
+        idlist_hook* prev = nullptr;
+        idlist_hook* next = nullptr;
+
+        constexpr idlist_hook() = default;
+        constexpr idlist_hook(const idlist_hook&) {}
+        constexpr idlist_hook& operator=(const idlist_hook&) { return *this; }
+
+        //Is the owning object currently in a list?
+        constexpr bool is_linked() const { return next != nullptr; }
+    };
+
+    /*
+        Converts between an object and the hook member 'Hook' embedded in it. T must be standard-layout, the
+        same requirement offsetof has, so the hook sits at one fixed offset that is worked out once and owner()
+        is a constant subtraction.
+    */
+    template<typename T, typename H, H T::* Hook>
+    struct hook_traits
+    {
+        static_assert(std::is_standard_layout_v<T>, "Objects in an intrusive list must be standard-layout.");
+
+    private:
+        //Measures the hook's offset from the member pointer against static storage that is never read.
+        static std::size_t find_offset()
+        {
+            alignas(T) static unsigned char probe[sizeof(T)];
+            T* object = reinterpret_cast<T*>(probe);
+
+            return static_cast<std::size_t>(reinterpret_cast<unsigned char*>(&(object->*Hook)) - probe);
+        }
+
+    public:
+        //Byte offset of the hook inside T.
+        static inline const std::size_t offset = find_offset();
+
+        static constexpr H* hook(T& object) { return &(object.*Hook); }
+
+        static T* owner(H* hook)
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) - offset);
+        }
+    };
+
+    //This iterator meets the 'LegacyForwardIterator' standard for forward_lists.
+    template<typename T, islist_hook T::* Hook>
+    struct is_iterator
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using traits = hook_traits<T, islist_hook, Hook>;
+
+        islist_hook* node = nullptr;
+
+        //Get the underlying hook.
+        constexpr islist_hook* get() const { return node; }
+
+        constexpr T& operator*() { return *traits::owner(node); }
+        constexpr const T& operator*() const { return *traits::owner(node); }
+
+        constexpr T* operator->() { return traits::owner(node); }
+        constexpr const T* operator->() const { return traits::owner(node); }
+
+        constexpr is_iterator operator+(size_type index) const
+        {
+            is_iterator it = *this;
+            it += index;
+            return it;
+        }
+
+        constexpr is_iterator& operator+=(size_type index)
+        {
+            while(index != 0u)
+            {
+                node = node->next;
+                --index;
+            }
+
+            return *this;
+        }
+
+        constexpr is_iterator& operator++() //prefix
+        {
+            node = node->next;
+            return *this;
+        }
+
+        constexpr is_iterator operator++(int) //postfix
+        {
+            is_iterator old = *this;
+            node = node->next;
+            return old;
+        }
+    };
+
+    template<typename T, islist_hook T::* Hook>
+    inline constexpr bool operator==(const is_iterator<T, Hook>& lhs, const is_iterator<T, Hook>& rhs)
+    {
+        return lhs.node == rhs.node;
+    }
+
+    template<typename T, islist_hook T::* Hook>
+    inline constexpr bool operator!=(const is_iterator<T, Hook>& lhs, const is_iterator<T, Hook>& rhs)
+    {
+        return lhs.node != rhs.node;
+    }
+
+    /*
+        A singley-linked list that threads existing objects together through an islist_hook member instead of
+        allocating nodes for them. Linking and unlinking never allocate, and the list does not own its
+        objects: they must outlive their time in the list and can be in only one list per hook. The last hook
+        links back to a sentinel inside the list, so before_begin() works like std::forward_list's.
+    */
+    template<typename T, islist_hook T::* Hook>
+    class intrusive_slist
+    {
+        using traits = hook_traits<T, islist_hook, Hook>;
+
+    public:
+
+        using size_type = std::size_t;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+
+        using iterator = is_iterator<T, Hook>;
+        using const_iterator = const is_iterator<T, Hook>;
+
+    private:
+
+        islist_hook m_head;
+        islist_hook* m_tail = &m_head;
+        size_type m_count = 0;
+
+        constexpr islist_hook* sentinel() const { return const_cast<islist_hook*>(&m_head); }
+
+        constexpr void link_after(islist_hook* spot, islist_hook* hook)
+        {
+            hook->next = spot->next;
+            spot->next = hook;
+
+            if(spot == m_tail) m_tail = hook;
+            ++m_count;
+        }
+
+        //Takes over the chain of another list, leaving it empty.
+        constexpr void take(intrusive_slist& other)
+        {
+            if(other.empty()) return;
+
+            m_head.next = other.m_head.next;
+            m_tail = other.m_tail;
+            m_tail->next = &m_head;
+            m_count = other.m_count;
+
+            other.m_head.next = &other.m_head;
+            other.m_tail = &other.m_head;
+            other.m_count = 0;
+        }
+
+    public:
+        constexpr intrusive_slist() { m_head.next = &m_head; }
+
+        intrusive_slist(const intrusive_slist&) = delete;
+        intrusive_slist& operator=(const intrusive_slist&) = delete;
+
+        constexpr intrusive_slist(intrusive_slist&& other) noexcept
+        {
+            m_head.next = &m_head;
+            take(other);
+        }
+
+        constexpr intrusive_slist& operator=(intrusive_slist&& other) noexcept
+        {
+            if(this != &other)
+            {
+                clear();
+                take(other);
+            }
+
+            return *this;
+        }
+
+        constexpr ~intrusive_slist() { clear(); }
+
+        //Return the first object.
+        constexpr reference front() { return *begin(); }
+
+        //Return the first object.
+        constexpr const_reference front() const { return *begin(); }
+
+        //Return the last object.
+        constexpr reference back() { return *iterator{ m_tail }; }
+
+        //Return the last object.
+        constexpr const_reference back() const { return *iterator{ m_tail }; }
+
+        //Link an object at the front. It must not already be linked through this hook.
+        constexpr iterator push_front(T& value)
+        {
+            link_after(&m_head, traits::hook(value));
+            return begin();
+        }
+
+        //Link an object at the back. It must not already be linked through this hook.
+        constexpr iterator push_back(T& value)
+        {
+            link_after(m_tail, traits::hook(value));
+            return iterator{ m_tail };
+        }
+
+        //Unlink the first object.
+        constexpr void pop_front() { erase_after(before_begin()); }
+
+        //Link an object after the specified location. It must not already be linked through this hook.
+        constexpr iterator insert_after(iterator loc, T& value)
+        {
+            islist_hook* hook = traits::hook(value);
+            link_after(loc.get(), hook);
+
+            return iterator{ hook };
+        }
+
+        //Unlink the object after the specified location. Returns an iterator to the object after it.
+        constexpr iterator erase_after(iterator loc)
+        {
+            islist_hook* spot = loc.get();
+            islist_hook* hook = spot->next;
+
+            if(hook == &m_head) return end();
+
+            spot->next = hook->next;
+            hook->next = nullptr;
+
+            if(hook == m_tail) m_tail = spot;
+            --m_count;
+
+            return iterator{ spot->next };
+        }
+
+        //Get an iterator to an object in this list without searching for it.
+        constexpr iterator iterator_to(T& value) { return iterator{ traits::hook(value) }; }
+
+        //Get the number of objects currently in the list.
+        constexpr size_type size() const { return m_count; }
+
+        //Unlink every object. The objects themselves are left untouched.
+        constexpr void clear()
+        {
+            islist_hook* hook = m_head.next;
+
+            while(hook != &m_head)
+            {
+                islist_hook* next = hook->next;
+                hook->next = nullptr;
+                hook = next;
+            }
+
+            m_head.next = &m_head;
+            m_tail = &m_head;
+            m_count = 0;
+        }
+
+        //Get an iterator to the location before the start of the list, for insert_after and erase_after.
+        constexpr iterator before_begin() { return iterator{ &m_head }; }
+
+        //Get an iterator to the location before the start of the list, for insert_after and erase_after.
+        constexpr const_iterator before_begin() const { return iterator{ sentinel() }; }
+
+        //Get an iterator to the start of the list.
+        constexpr iterator begin() { return iterator{ m_head.next }; }
+
+        //Get an iterator to the start of the list.
+        constexpr const_iterator begin() const { return iterator{ m_head.next }; }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr iterator end() { return iterator{ &m_head }; }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr const_iterator end() const { return iterator{ sentinel() }; }
+
+        //Is the list empty?
+        [[nodiscard("This function does not empty the list.")]] constexpr bool empty() const
+        {
+            return m_count == 0;
+        }
+    };
+
+    template<os_compatible T, islist_hook T::* Hook>
+    inline std::ostream& operator<<(std::ostream& os, const intrusive_slist<T, Hook>& list)
+    {
+        os << "{ ";
+
+        bool first_item = true;
+
+        for(auto& item : list)
+        {
+            if(first_item)
+                first_item = false;
+            else
+                os << ", ";
+
+            os << item;
+        }
+
+        os << " }";
+
+        return os;
+    }
+
+
+    //This iterator meets the 'LegacyBidirectionalIterator' standard for lists.
+    template<typename T, idlist_hook T::* Hook>
+    struct id_iterator
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using traits = hook_traits<T, idlist_hook, Hook>;
+
+        idlist_hook* node = nullptr;
+
+        //Get the underlying hook.
+        constexpr idlist_hook* get() const { return node; }
+
+        constexpr T& operator*() { return *traits::owner(node); }
+        constexpr const T& operator*() const { return *traits::owner(node); }
+
+        constexpr T* operator->() { return traits::owner(node); }
+        constexpr const T* operator->() const { return traits::owner(node); }
+
+        constexpr id_iterator operator+(size_type index) const
+        {
+            id_iterator it = *this;
+            it += index;
+            return it;
+        }
+
+        constexpr id_iterator operator-(size_type index) const
+        {
+            id_iterator it = *this;
+            it -= index;
+            return it;
+        }
+
+        constexpr id_iterator& operator+=(size_type index)
+        {
+            while(index != 0u)
+            {
+                node = node->next;
+                --index;
+            }
+
+            return *this;
+        }
+
+        constexpr id_iterator& operator-=(size_type index)
+        {
+            while(index != 0u)
+            {
+                node = node->prev;
+                --index;
+            }
+
+            return *this;
+        }
+
+        constexpr id_iterator& operator++() //prefix
+        {
+            node = node->next;
+            return *this;
+        }
+
+        constexpr id_iterator operator++(int) //postfix
+        {
+            id_iterator old = *this;
+            node = node->next;
+            return old;
+        }
+
+        constexpr id_iterator& operator--() //prefix
+        {
+            node = node->prev;
+            return *this;
+        }
+
+        constexpr id_iterator operator--(int) //postfix
+        {
+            id_iterator old = *this;
+            node = node->prev;
+            return old;
+        }
+    };
+
+    template<typename T, idlist_hook T::* Hook>
+    inline constexpr bool operator==(const id_iterator<T, Hook>& lhs, const id_iterator<T, Hook>& rhs)
+    {
+        return lhs.node == rhs.node;
+    }
+
+    template<typename T, idlist_hook T::* Hook>
+    inline constexpr bool operator!=(const id_iterator<T, Hook>& lhs, const id_iterator<T, Hook>& rhs)
+    {
+        return lhs.node != rhs.node;
+    }
+
+    /*
+        A doubley-linked list that threads existing objects together through an idlist_hook member instead of
+        allocating nodes for them. Linking and unlinking never allocate, and any object can be unlinked in O(1)
+        through remove() without searching for it. The list does not own its objects: they must outlive their
+        time in the list and can be in only one list per hook, though an object with several hooks can be in
+        several lists at once. The hooks form a ring through a sentinel inside the list, so --end() is the
+        last object.
+    */
+    template<typename T, idlist_hook T::* Hook>
+    class intrusive_dlist
+    {
+        using traits = hook_traits<T, idlist_hook, Hook>;
+
+    public:
+
+        using size_type = std::size_t;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+
+        using iterator = id_iterator<T, Hook>;
+        using const_iterator = const id_iterator<T, Hook>;
+
+    private:
+
+        idlist_hook m_head;
+        size_type m_count = 0;
+
+        constexpr idlist_hook* sentinel() const { return const_cast<idlist_hook*>(&m_head); }
+
+        //Links 'hook' in before 'spot'.
+        constexpr void link_before(idlist_hook* spot, idlist_hook* hook)
+        {
+            hook->next = spot;
+            hook->prev = spot->prev;
+            spot->prev->next = hook;
+            spot->prev = hook;
+
+            ++m_count;
+        }
+
+        constexpr void unlink(idlist_hook* hook)
+        {
+            hook->prev->next = hook->next;
+            hook->next->prev = hook->prev;
+            hook->prev = nullptr;
+            hook->next = nullptr;
+
+            --m_count;
+        }
+
+        constexpr void reset()
+        {
+            m_head.prev = &m_head;
+            m_head.next = &m_head;
+            m_count = 0;
+        }
+
+        //Takes over the ring of another list, leaving it empty.
+        constexpr void take(intrusive_dlist& other)
+        {
+            if(other.empty()) return;
+
+            m_head.next = other.m_head.next;
+            m_head.prev = other.m_head.prev;
+            m_head.next->prev = &m_head;
+            m_head.prev->next = &m_head;
+            m_count = other.m_count;
+
+            other.reset();
+        }
+
+    public:
+        constexpr intrusive_dlist() { reset(); }
+
+        intrusive_dlist(const intrusive_dlist&) = delete;
+        intrusive_dlist& operator=(const intrusive_dlist&) = delete;
+
+        constexpr intrusive_dlist(intrusive_dlist&& other) noexcept
+        {
+            reset();
+            take(other);
+        }
+
+        constexpr intrusive_dlist& operator=(intrusive_dlist&& other) noexcept
+        {
+            if(this != &other)
+            {
+                clear();
+                take(other);
+            }
+
+            return *this;
+        }
+
+        constexpr ~intrusive_dlist() { clear(); }
+
+        //Return the first object.
+        constexpr reference front() { return *begin(); }
+
+        //Return the first object.
+        constexpr const_reference front() const { return *begin(); }
+
+        //Return the last object.
+        constexpr reference back() { return *iterator{ m_head.prev }; }
+
+        //Return the last object.
+        constexpr const_reference back() const { return *iterator{ m_head.prev }; }
+
+        //Link an object at the front. It must not already be linked through this hook.
+        constexpr iterator push_front(T& value)
+        {
+            link_before(m_head.next, traits::hook(value));
+            return begin();
+        }
+
+        //Link an object at the back. It must not already be linked through this hook.
+        constexpr iterator push_back(T& value)
+        {
+            link_before(&m_head, traits::hook(value));
+            return iterator{ m_head.prev };
+        }
+
+        //Unlink the first object.
+        constexpr void pop_front()
+        {
+            if(empty()) return;
+            unlink(m_head.next);
+        }
+
+        //Unlink the last object.
+        constexpr void pop_back()
+        {
+            if(empty()) return;
+            unlink(m_head.prev);
+        }
+
+        //Link an object before the specified location. It must not already be linked through this hook.
+        constexpr iterator insert(iterator loc, T& value)
+        {
+            idlist_hook* hook = traits::hook(value);
+            link_before(loc.get(), hook);
+
+            return iterator{ hook };
+        }
+
+        //Unlink the object at the specified location. Returns an iterator to the object after it.
+        constexpr iterator erase(iterator loc)
+        {
+            idlist_hook* hook = loc.get();
+
+            if(hook == &m_head) return end();
+
+            idlist_hook* next = hook->next;
+            unlink(hook);
+
+            return iterator{ next };
+        }
+
+        /*
+            Unlink an object that is in this list in O(1). Returns false if the object is not linked at all. The
+            hook cannot tell which list it is in, so the object must not be linked into another list through
+            this hook; that list would lose it while this one's size() dropped.
+        */
+        constexpr bool remove(T& value)
+        {
+            idlist_hook* hook = traits::hook(value);
+
+            //Not linked anywhere. Being linked is taken to mean linked into this list.
+            if(!hook->is_linked()) return false;
+
+            unlink(hook);
+            return true;
+        }
+
+        //Get an iterator to an object in this list without searching for it.
+        constexpr iterator iterator_to(T& value) { return iterator{ traits::hook(value) }; }
+
+        //Get the number of objects currently in the list.
+        constexpr size_type size() const { return m_count; }
+
+        //Unlink every object. The objects themselves are left untouched.
+        constexpr void clear()
+        {
+            idlist_hook* hook = m_head.next;
+
+            while(hook != &m_head)
+            {
+                idlist_hook* next = hook->next;
+                hook->prev = nullptr;
+                hook->next = nullptr;
+                hook = next;
+            }
+
+            reset();
+        }
+
+        //Get an iterator to the start of the list.
+        constexpr iterator begin() { return iterator{ m_head.next }; }
+
+        //Get an iterator to the start of the list.
+        constexpr const_iterator begin() const { return iterator{ m_head.next }; }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr iterator end() { return iterator{ &m_head }; }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr const_iterator end() const { return iterator{ sentinel() }; }
+
+        //Is the list empty?
+        [[nodiscard("This function does not empty the list.")]] constexpr bool empty() const
+        {
+            return m_count == 0;
+        }
+    };
+
+    template<os_compatible T, idlist_hook T::* Hook>
+    inline std::ostream& operator<<(std::ostream& os, const intrusive_dlist<T, Hook>& list)
+    {
+        os << "{ ";
+
+        bool first_item = true;
+
+        for(auto& item : list)
+        {
+            if(first_item)
+                first_item = false;
+            else
+                os << ", ";
+
+            os << item;
+        }
+
+        os << " }";
+
+        return os;
+    }
+
+} // namespace aggro
+
+#endif // AGGRO_INTRUSIVE_LIST_HPP
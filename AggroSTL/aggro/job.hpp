@@ -0,0 +1,486 @@
+#ifndef AGGRO_JOB_HPP
+#define AGGRO_JOB_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include "utility.hpp"
+#include "array.hpp"
+
+namespace aggro
+{
+    template<typename Signature, std::size_t Capacity>
+    class inline_function;
+
+    /*
+        A callable wrapper that stores its target in a fixed buffer of 'Capacity' bytes and never allocates.
+        A target that does not fit is a compile error rather than a silent heap fallback. It is neither
+        copyable nor movable: the target is constructed where the wrapper lives with assign() and destroyed
+        with reset().
+    */
+    template<typename R, typename... Args, std::size_t Capacity>
+    class inline_function<R(Args...), Capacity>
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type capacity = Capacity;
+
+    private:
+        alignas(std::max_align_t) unsigned char m_storage[Capacity];
+        R (*m_invoke)(void*, Args&&...) = nullptr;
+        void (*m_destroy)(void*) = nullptr;
+
+    public:
+        constexpr inline_function() = default;
+
+        template<typename F> requires (!same<std::decay_t<F>, inline_function>)
+        inline_function(F&& func)
+        {
+            assign(aggro::forward<F>(func));
+        }
+
+        inline_function(const inline_function&) = delete;
+        inline_function& operator=(const inline_function&) = delete;
+
+        ~inline_function() { reset(); }
+
+        //Destroys the current target, if any, and stores 'func' in its place.
+        template<typename F>
+        void assign(F&& func)
+        {
+            using target = std::decay_t<F>;
+
+            static_assert(sizeof(target) <= Capacity, "The callable is too large for this inline_function.");
+            static_assert(alignof(target) <= alignof(std::max_align_t), "Over-aligned callables are not supported.");
+
+            reset();
+            new(m_storage) target(aggro::forward<F>(func));
+
+            m_invoke = [](void* object, Args&&... args) -> R
+            {
+                return (*static_cast<target*>(object))(aggro::forward<Args>(args)...);
+            };
+
+            m_destroy = [](void* object) { static_cast<target*>(object)->~target(); };
+        }
+
+        //Destroys the current target, if any.
+        void reset()
+        {
+            if (m_destroy) m_destroy(m_storage);
+
+            m_invoke = nullptr;
+            m_destroy = nullptr;
+        }
+
+        R operator()(Args... args) { return m_invoke(m_storage, aggro::forward<Args>(args)...); }
+
+        explicit operator bool() const { return m_invoke != nullptr; }
+    };
+
+    /*
+        A fixed-capacity Chase-Lev work-stealing deque of pointers. The owning thread pushes and pops at the
+        bottom without contention; other threads steal from the top and only race with each other, or with
+        the owner over the very last element, through one compare-exchange. Follows the C11 formulation by
+        Le, Pop, Cohen and Zappa Nardelli. N must be a power of two, and the owner must never push more than
+        N items that have not been popped or stolen.
+    */
+    template<typename T, std::size_t N>
+    class steal_deque
+    {
+        static_assert(N > 0u && (N & (N - 1u)) == 0u, "A steal_deque capacity must be a power of two.");
+
+    public:
+        using size_type = std::size_t;
+
+    private:
+        alignas(cache_line_size) std::atomic<std::int64_t> m_top { 0 };
+        alignas(cache_line_size) std::atomic<std::int64_t> m_bottom { 0 };
+        alignas(cache_line_size) array<std::atomic<T*>, N> m_items;
+
+        std::atomic<T*>& slot(std::int64_t index) { return m_items[static_cast<size_type>(index) & (N - 1u)]; }
+
+    public:
+        steal_deque() = default;
+
+        steal_deque(const steal_deque&) = delete;
+        steal_deque& operator=(const steal_deque&) = delete;
+
+        //Owner thread only.
+        void push(T* item)
+        {
+            const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+
+            slot(bottom).store(item, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        //Takes the most recently pushed item, or nullptr if the deque is empty. Owner thread only.
+        T* pop()
+        {
+            const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = slot(bottom).load(std::memory_order_relaxed);
+
+            if (top == bottom)
+            {
+                //Last item: race the thieves for it.
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        //Takes the oldest item, or nullptr if the deque is empty or another thread got there first.
+        //Any thread.
+        T* steal()
+        {
+            std::int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) return nullptr;
+
+            T* item = slot(top).load(std::memory_order_relaxed);
+
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return item;
+        }
+
+        //A snapshot that may be stale by the time it is read.
+        size_type size() const
+        {
+            const std::int64_t count = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+            return count > 0 ? static_cast<size_type>(count) : 0u;
+        }
+    };
+
+    //Counts the jobs submitted against it that have not finished yet. Pass it to job_system::wait().
+    struct job_counter
+    {
+        std::atomic<std::uint32_t> value { 0u };
+
+        bool done() const { return value.load(std::memory_order_acquire) == 0u; }
+    };
+
+    //Closure storage of a job. Sized so a whole job fills two cache lines.
+    using job_function = inline_function<void(), 80u>;
+
+    /*
+        A unit of work. A job is finished once its function has returned and every child submitted
+        against it has finished; only then is its counter decremented and its parent told.
+    */
+    struct alignas(cache_line_size) job
+    {
+        job_function function;
+        job* parent = nullptr;
+        job_counter* counter = nullptr;
+        std::atomic<std::uint32_t> unfinished { 0u }; //This job plus its unfinished children.
+    };
+
+    /*
+        A fixed pool of worker threads that share jobs through per-worker work-stealing deques. The thread
+        that constructs the job_system is worker 0: it runs jobs while it waits, so a job_system with no extra
+        threads still makes progress. Each worker takes jobs from the bottom of its own deque first, which
+        keeps freshly split work hot in its cache, and steals from the top of a random victim's deque when its
+        own runs dry. Idle workers spin briefly and then sleep until the next submit.
+
+        Jobs live in a per-worker ring of 'jobs_per_worker' slots and closures are stored inline, so submit()
+        never allocates. If the ring wraps onto a job that has not finished yet, or submit() is called from a
+        thread outside the system, the new job runs immediately on the calling thread instead of being queued,
+        and submit() returns once it and all of its children have finished.
+    */
+    class job_system
+    {
+    public:
+        using size_type = std::size_t;
+
+        static constexpr size_type jobs_per_worker = 4096u;
+
+        //Spins before an idle worker goes to sleep.
+        static constexpr size_type idle_spins = 64u;
+
+    private:
+        struct alignas(cache_line_size) worker
+        {
+            steal_deque<job, jobs_per_worker> deque;
+            array<job, jobs_per_worker> jobs;
+            size_type next_job = 0u;
+            std::uint32_t seed = 0u;
+            job_system* owner = nullptr;
+        };
+
+        worker* m_workers = nullptr;
+        size_type m_count = 0u;
+        std::thread* m_threads = nullptr;
+
+        alignas(cache_line_size) std::atomic<std::uint32_t> m_epoch { 0u }; //Bumped by every submit, idle workers wait on it.
+        std::atomic<bool> m_stop { false };
+
+        static inline thread_local worker* t_worker = nullptr;
+        static inline thread_local job* t_job = nullptr;
+
+        //The calling thread's worker, or nullptr if it does not belong to this system.
+        worker* local() const
+        {
+            return (t_worker && t_worker->owner == this) ? t_worker : nullptr;
+        }
+
+        //Takes the next slot of the worker's ring, or returns nullptr if the job in it has not finished yet.
+        //Waiting for the slot could deadlock when that job is running further up the calling thread's stack.
+        static job* allocate(worker& w)
+        {
+            job* j = &w.jobs[w.next_job & (jobs_per_worker - 1u)];
+
+            if (j->unfinished.load(std::memory_order_acquire) != 0u) return nullptr;
+
+            ++w.next_job;
+            return j;
+        }
+
+        //Retires one unit of 'j'. The last one decrements its counter and passes the retirement on to the parent.
+        static void finish(job* j)
+        {
+            while (j)
+            {
+                job* parent = j->parent;
+                job_counter* counter = j->counter;
+
+                if (j->unfinished.fetch_sub(1u, std::memory_order_acq_rel) != 1u) return;
+
+                if (counter) counter->value.fetch_sub(1u, std::memory_order_release);
+
+                j = parent;
+            }
+        }
+
+        static void execute(job* j)
+        {
+            job* outer = t_job;
+            t_job = j;
+
+            j->function();
+            j->function.reset();
+
+            t_job = outer;
+            finish(j);
+        }
+
+        job* steal(worker& w)
+        {
+            w.seed ^= w.seed << 13;
+            w.seed ^= w.seed >> 17;
+            w.seed ^= w.seed << 5;
+
+            const size_type start = w.seed % m_count;
+
+            for (size_type i = 0; i < m_count; i++)
+            {
+                worker& victim = m_workers[(start + i) % m_count];
+
+                if (&victim == &w) continue;
+
+                if (job* j = victim.deque.steal()) return j;
+            }
+
+            return nullptr;
+        }
+
+        //Runs one job from the local deque or stolen from another worker. Returns false if none was found.
+        bool run_one(worker& w)
+        {
+            job* j = w.deque.pop();
+
+            if (j == nullptr) j = steal(w);
+            if (j == nullptr) return false;
+
+            execute(j);
+            return true;
+        }
+
+        void worker_loop(worker& w)
+        {
+            t_worker = &w;
+
+            while (true)
+            {
+                const std::uint32_t seen = m_epoch.load(std::memory_order_acquire);
+
+                if (m_stop.load(std::memory_order_acquire)) break;
+                if (run_one(w)) continue;
+
+                bool found = false;
+
+                for (size_type i = 0; i < idle_spins && !found; i++)
+                    found = run_one(w);
+
+                if (!found) m_epoch.wait(seen, std::memory_order_acquire);
+            }
+
+            t_worker = nullptr;
+        }
+
+        /*
+            Runs 'func' on the calling thread as a job of its own, linked to 'counter' and 'parent' like a queued
+            one, so children it submits through current_job() are counted against it. Does not return until those
+            children have finished too, since the job lives on this stack frame; runs other jobs while it waits.
+        */
+        template<typename F>
+        void run_inline(F& func, job_counter* counter, job* parent, worker* w)
+        {
+            job j;
+            j.parent = parent;
+            j.counter = counter;
+            j.unfinished.store(1u, std::memory_order_relaxed);
+
+            if (counter) counter->value.fetch_add(1u, std::memory_order_relaxed);
+            if (parent) parent->unfinished.fetch_add(1u, std::memory_order_relaxed);
+
+            job* outer = t_job;
+            t_job = &j;
+
+            func();
+
+            t_job = outer;
+            finish(&j);
+
+            while (j.unfinished.load(std::memory_order_acquire) != 0u)
+            {
+                if (w == nullptr || !run_one(*w)) std::this_thread::yield();
+            }
+        }
+
+        template<typename F>
+        job* push(F&& func, job_counter* counter, job* parent)
+        {
+            worker* w = local();
+            job* j = w ? allocate(*w) : nullptr;
+
+            if (j == nullptr)
+            {
+                run_inline(func, counter, parent, w);
+                return nullptr;
+            }
+
+            j->function.assign(aggro::forward<F>(func));
+            j->parent = parent;
+            j->counter = counter;
+            j->unfinished.store(1u, std::memory_order_relaxed);
+
+            if (counter) counter->value.fetch_add(1u, std::memory_order_relaxed);
+            if (parent) parent->unfinished.fetch_add(1u, std::memory_order_relaxed);
+
+            w->deque.push(j);
+
+            m_epoch.fetch_add(1u, std::memory_order_release);
+            m_epoch.notify_one();
+
+            return j;
+        }
+
+    public:
+        //A worker count that leaves one hardware thread per core busy, counting the calling thread.
+        static size_type default_threads()
+        {
+            const unsigned int hw = std::thread::hardware_concurrency();
+            return hw > 1u ? hw - 1u : 0u;
+        }
+
+        //Starts 'threads' worker threads. The calling thread becomes worker 0 on top of them.
+        explicit job_system(size_type threads = default_threads())
+            : m_count(threads + 1u)
+        {
+            m_workers = new worker[m_count];
+
+            for (size_type i = 0; i < m_count; i++)
+            {
+                m_workers[i].owner = this;
+                m_workers[i].seed = static_cast<std::uint32_t>(i * 2654435761u + 1u);
+            }
+
+            t_worker = &m_workers[0];
+
+            m_threads = static_cast<std::thread*>(::operator new(sizeof(std::thread) * threads));
+
+            for (size_type i = 0; i < threads; i++)
+                new(m_threads + i) std::thread([this, i]() { worker_loop(m_workers[i + 1u]); });
+        }
+
+        job_system(const job_system&) = delete;
+        job_system& operator=(const job_system&) = delete;
+
+        //Stops and joins the worker threads. Wait for outstanding jobs first; unstarted jobs are dropped.
+        ~job_system()
+        {
+            m_stop.store(true, std::memory_order_release);
+            m_epoch.fetch_add(1u, std::memory_order_release);
+            m_epoch.notify_all();
+
+            for (size_type i = 0; i + 1u < m_count; i++)
+            {
+                m_threads[i].join();
+                m_threads[i].~thread();
+            }
+
+            ::operator delete(m_threads);
+
+            if (t_worker && t_worker->owner == this) t_worker = nullptr;
+
+            delete[] m_workers;
+        }
+
+        //Queues 'func' on the calling worker. 'counter' is incremented now and decremented once the job and
+        //all of its children have finished. Returns nullptr if the job ran immediately instead.
+        template<typename F>
+        job* submit(F&& func, job_counter& counter)
+        {
+            return push(aggro::forward<F>(func), &counter, nullptr);
+        }
+
+        //Queues 'func' as a child of 'parent', which will not finish until this job has. Call it while the
+        //parent is still running, typically from inside the parent's own function through current_job().
+        //Returns nullptr if the job ran immediately instead.
+        template<typename F>
+        job* submit(F&& func, job* parent)
+        {
+            return push(aggro::forward<F>(func), nullptr, parent);
+        }
+
+        //Runs jobs on the calling thread until every job counted by 'counter' has finished.
+        void wait(const job_counter& counter)
+        {
+            worker* w = local();
+
+            while (!counter.done())
+            {
+                if (w == nullptr || !run_one(*w)) std::this_thread::yield();
+            }
+        }
+
+        //The job running on the calling thread, or nullptr outside of a job.
+        static job* current_job() { return t_job; }
+
+        //Number of workers, including the thread that constructed the system.
+        size_type worker_count() const { return m_count; }
+    };
+
+} // namespace aggro
+
+#endif // AGGRO_JOB_HPP
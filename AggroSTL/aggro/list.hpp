@@ -2,12 +2,119 @@
 #define LIST_HPP
 
 #include <initializer_list>
+#include <functional>
 #include "utility.hpp"
 #include "concepts/stream.hpp"
 #include "allocators/standard.hpp"
 
 namespace aggro
 {
+    namespace list_detail
+    {
+        //Most runs a list sort keeps at once. Run i holds 2^i nodes, so this covers any list that fits in memory.
+        inline constexpr std::size_t sort_bins = 64u;
+
+        /*
+            Merges two sorted chains linked through 'next' and returns the new head. Nodes from 'a' go first
+            when they compare equal, so the merge is stable. Only 'next' is written.
+        */
+        template<typename Node, typename Compare>
+        constexpr Node* merge_chains(Node* a, Node* b, Compare& comp)
+        {
+            Node* head = nullptr;
+            Node** link = &head;
+
+            while(a && b)
+            {
+                if(comp(b->value, a->value))
+                {
+                    *link = b;
+                    link = &b->next;
+                    b = b->next;
+                }
+                else
+                {
+                    *link = a;
+                    link = &a->next;
+                    a = a->next;
+                }
+            }
+
+            *link = a ? a : b;
+
+            return head;
+        }
+
+        /*
+            Bottom-up merge sort of a null-terminated chain. Nodes are taken one at a time and carried up through
+            a stack of runs of doubling length, the way a binary counter carries, so every node is touched
+            O(log n) times and nothing is allocated. Stable. Only 'next' is written.
+        */
+        template<typename Node, typename Compare>
+        constexpr Node* sort_chain(Node* head, Compare& comp)
+        {
+            Node* bins[sort_bins] = {};
+            std::size_t used = 0u;
+
+            while(head)
+            {
+                Node* run = head;
+                head = head->next;
+                run->next = nullptr;
+
+                std::size_t i = 0u;
+
+                for(; i < used && bins[i]; ++i)
+                {
+                    run = merge_chains(bins[i], run, comp);
+                    bins[i] = nullptr;
+                }
+
+                if(i == sort_bins) --i;
+                if(i == used) ++used;
+
+                bins[i] = run;
+            }
+
+            Node* result = nullptr;
+
+            for(std::size_t i = 0u; i < used; ++i)
+            {
+                if(bins[i])
+                    result = merge_chains(bins[i], result, comp);
+            }
+
+            return result;
+        }
+
+        //Walks a chain of nodes and hands out each value as an rvalue, so a new chain can be built by moving from it.
+        template<typename Node>
+        struct move_walker
+        {
+            Node* node = nullptr;
+
+            constexpr typename Node::value_type&& operator*() const { return aggro::move(node->value); }
+
+            constexpr move_walker& operator++()
+            {
+                node = node->next;
+                return *this;
+            }
+        };
+
+        //Does every node of the chain sit right after the one before it in memory?
+        template<typename Node>
+        constexpr bool is_compact(const Node* node)
+        {
+            for(; node && node->next; node = node->next)
+            {
+                if(node->next != node + 1) return false;
+            }
+
+            return true;
+        }
+
+    } // namespace list_detail
     
     /*
         Node struct for a slist.
@@ -62,7 +169,7 @@ namespace aggro
             return *this;
         }
 
-        constexpr s_iterator& operator(size_type index)
+        constexpr s_iterator& operator+=(size_type index)
         {
             while (this->node && index != 0)
             {
@@ -136,13 +243,72 @@ namespace aggro
         allocator_type alloc;
         size_type m_count = 0;
 
+        //The node after 'node', or the front node when 'node' is null.
+        constexpr s_node* _after(s_node* node) { return node ? node->next : alloc.resource(); }
+
+        //Makes 'next' follow 'node', or makes it the front node when 'node' is null.
+        constexpr void _set_after(s_node* node, s_node* next)
+        {
+            if(node)
+                node->next = next;
+            else
+                alloc.set_head(next);
+        }
+
+        /*
+            Builds a chain of 'count' new nodes holding copies of the values from 'it' onwards. Returns the first
+            node and sets 'last' to the last one. Batch allocators hand out every node in one call, laid out in
+            list order, so walking the chain later runs through memory in sequence.
+        */
+        template<typename Iter>
+        constexpr s_node* _build_chain(Iter it, size_type count, s_node*& last)
+        {
+            last = nullptr;
+            if(count == 0u) return nullptr;
+
+            s_node* first = nullptr;
+
+            if constexpr (batch_allocator<allocator_type>)
+            {
+                first = alloc.allocate_batch(count);
+
+                for(size_type i = 0; i < count; ++i, ++it)
+                {
+                    first[i].next = first + i + 1u;
+                    alloc.construct(first + i, *it);
+                }
+
+                last = first + count - 1u;
+            }
+            else
+            {
+                for(size_type i = 0; i < count; ++i, ++it)
+                {
+                    s_node* node = alloc.allocate(1);
+                    alloc.construct(node, *it);
+
+                    if(last)
+                        last->next = node;
+                    else
+                        first = node;
+
+                    last = node;
+                }
+            }
+
+            last->next = nullptr;
+            m_count += count;
+
+            return first;
+        }
+
         template<typename... Args>
         constexpr s_node* _emplace(s_node* spot, Args&&... args)
         {
             s_node* new_node = alloc.allocate(1);
             new_node->next = spot;
 
-            alloc.construct(new_node, forward<Args>(args)...);
+            alloc.construct(new_node, aggro::forward<Args>(args)...);
             ++m_count;
             
             return new_node;
@@ -152,51 +318,20 @@ namespace aggro
         constexpr slist() = default;
         constexpr slist(const std::initializer_list<T>& init)
         {
-            size_type init_size = init.size();
-            s_node* current = nullptr;
-
-            for(size_type i = 0; i < init_size; ++i)
-            {
-                if(alloc.resource() == nullptr)
-                {
-                    alloc.set_head(_emplace(nullptr, move(*(init.begin() + i))));
-                    current = alloc.resource();
-                }
-                else
-                {
-                    current->next = _emplace(nullptr, move(*(init.begin() + i)));
-                    current = current->next;
-                }
-
-            }
+            insert_range_after(end(), init);
         }
 
         constexpr slist(const slist& other)
         {
-            s_node* current = nullptr;
-            
-            for(auto val : other)
-            {
-                if(alloc.resource() == nullptr)
-                {
-                    alloc.set_head(_emplace(nullptr, val));
-                    current = alloc.resource();
-                }
-                else
-                {
-                    current->next = _emplace(nullptr, val);
-                    current = current->next;
-                }
-
-            }
+            insert_range_after(end(), other);
         }
 
+        //Takes the nodes along with the allocator that owns them, so a pool or arena set on 'other' carries over.
         constexpr slist(slist&& other) noexcept
-        : m_count(other.size())
+        : alloc(move(other.alloc)), m_count(other.m_count)
         {
-            allocator_type* o_all = other.get_allocator();
-            alloc.set_head(o_all->resource());
-            o_all->unlink();
+            other.alloc.unlink();
+            other.m_count = 0;
         }
 
         constexpr ~slist() { clear(); }
@@ -225,7 +360,7 @@ namespace aggro
         template<typename... Args>
         constexpr iterator emplace_front(Args&&... args)
         {
-            alloc.set_head(_emplace(alloc.resource(), forward<Args>(args)...));
+            alloc.set_head(_emplace(alloc.resource(), aggro::forward<Args>(args)...));
             return iterator{ alloc.resource() };
         }
 
@@ -271,11 +406,11 @@ namespace aggro
         template<typename... Args>
         constexpr iterator emplace_after(iterator loc, Args&&... args)
         {
-            if(empty()) return emplace_front(forward<Args>(args)...);
+            if(empty()) return emplace_front(aggro::forward<Args>(args)...);
             if(loc.get() == nullptr) return iterator { nullptr };
             
             s_node* node = loc.get();
-            node->next = _emplace(node->next, forward<Args>(args)...);
+            node->next = _emplace(node->next, aggro::forward<Args>(args)...);
 
             return iterator{ node->next };
         }
@@ -298,6 +433,182 @@ namespace aggro
             }
         }
 
+        /*
+            Copies every value of 'range' into new nodes after 'pos', or at the front if 'pos' is end(), and
+            returns the last new node. With a batch allocator all of the nodes come from one allocation.
+        */
+        template<sized_range R>
+        constexpr iterator insert_range_after(iterator pos, const R& range)
+        {
+            s_node* last = nullptr;
+            s_node* first = _build_chain(range.begin(), static_cast<size_type>(range.size()), last);
+
+            if(first == nullptr) return pos;
+
+            last->next = _after(pos.get());
+            _set_after(pos.get(), first);
+
+            return iterator{ last };
+        }
+
+        //Copies every value of 'range' onto the back of the list. Walks the list once to find the back.
+        template<sized_range R>
+        constexpr iterator append_range(const R& range)
+        {
+            s_node* back = alloc.resource();
+
+            while(back && back->next)
+                back = back->next;
+
+            return insert_range_after(iterator{ back }, range);
+        }
+
+        /*
+            Moves the nodes after 'first' and before 'last' from 'other' to just after 'pos' by relinking them.
+            Nothing is allocated, copied or moved, so iterators and references to the moved values stay valid.
+            An end() position stands for the spot before the first node: as 'pos' it splices to the front, as
+            'first' it takes from the front of 'other'. Walks the moved nodes once to find the last of them.
+            'pos' must not be inside the moved range, and both lists' allocators must be able to free each
+            other's nodes.
+        */
+        constexpr void splice_after(iterator pos, slist& other, iterator first, iterator last)
+        {
+            s_node* first_node = other._after(first.get());
+            if(first_node == last.get()) return;
+
+            s_node* last_node = first_node;
+            size_type moved = 1u;
+
+            while(last_node->next != last.get())
+            {
+                last_node = last_node->next;
+                ++moved;
+            }
+
+            other._set_after(first.get(), last.get());
+            last_node->next = _after(pos.get());
+            _set_after(pos.get(), first_node);
+
+            other.m_count -= moved;
+            m_count += moved;
+        }
+
+        //Moves every node of 'other' to just after 'pos', or to the front if 'pos' is end().
+        constexpr void splice_after(iterator pos, slist& other)
+        {
+            if(&other == this) return;
+            splice_after(pos, other, other.end(), other.end());
+        }
+
+        //Moves the node after 'it' in 'other' to just after 'pos' in O(1). An end() 'it' moves the front node.
+        constexpr void splice_after(iterator pos, slist& other, iterator it)
+        {
+            s_node* node = other._after(it.get());
+            if(node == nullptr) return;
+            if(&other == this && (pos.get() == it.get() || pos.get() == node)) return;
+
+            other._set_after(it.get(), node->next);
+            node->next = _after(pos.get());
+            _set_after(pos.get(), node);
+
+            --other.m_count;
+            ++m_count;
+        }
+
+        /*
+            Merges the sorted list 'other' into this sorted list by relinking nodes, leaving 'other' empty.
+            Equal values from this list stay ahead of those from 'other'.
+        */
+        template<typename Compare = std::less<>>
+        constexpr void merge(slist& other, Compare comp = Compare{})
+        {
+            if(&other == this) return;
+
+            alloc.set_head(list_detail::merge_chains(alloc.resource(), other.alloc.resource(), comp));
+            m_count += other.m_count;
+
+            other.m_count = 0;
+            other.alloc.set_head(nullptr);
+        }
+
+        //Stable in-place merge sort. Relinks the existing nodes and never allocates.
+        template<typename Compare = std::less<>>
+        constexpr void sort(Compare comp = Compare{})
+        {
+            alloc.set_head(list_detail::sort_chain(alloc.resource(), comp));
+        }
+
+        //Removes every node equal to the node before it and returns how many were removed.
+        template<typename Predicate = std::equal_to<>>
+        constexpr size_type unique(Predicate pred = Predicate{})
+        {
+            size_type removed = 0u;
+            s_node* node = alloc.resource();
+
+            while(node && node->next)
+            {
+                s_node* next = node->next;
+
+                if(pred(node->value, next->value))
+                {
+                    node->next = next->next;
+                    next->~s_node();
+                    alloc.deallocate(next, 1);
+                    ++removed;
+                }
+                else
+                {
+                    node = next;
+                }
+            }
+
+            m_count -= removed;
+            return removed;
+        }
+
+        //Reverses the order of the nodes in place.
+        constexpr void reverse()
+        {
+            s_node* node = alloc.resource();
+            s_node* prev = nullptr;
+
+            while(node)
+            {
+                s_node* next = node->next;
+                node->next = prev;
+                prev = node;
+                node = next;
+            }
+
+            alloc.set_head(prev);
+        }
+
+        /*
+            Moves every value into new nodes laid out in list order and frees the old ones, so later walks run
+            through memory in sequence. A batch allocator hands out all of the new nodes at once; otherwise they
+            are allocated one at a time in list order, which most heaps place close together. Both sets of nodes
+            are held at the peak. Invalidates every iterator and reference. Does nothing if the nodes are
+            already in order.
+        */
+        constexpr void compact()
+        {
+            s_node* old_node = alloc.resource();
+            if(list_detail::is_compact(old_node)) return;
+
+            const size_type count = m_count;
+            s_node* last = nullptr;
+
+            alloc.set_head(_build_chain(list_detail::move_walker<s_node>{ old_node }, count, last));
+            m_count = count;
+
+            while(old_node)
+            {
+                s_node* next = old_node->next;
+                old_node->~s_node();
+                alloc.deallocate(old_node, 1);
+                old_node = next;
+            }
+        }
 
         //Get the number of nodes currently in the list.
         constexpr size_type size() const { return m_count; }
@@ -320,7 +631,10 @@ namespace aggro
         }
 
         //Get a pointer to the underlying allocator.
-        constexpr allocator_type* get_allocator() const noexcept { return &alloc; }
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
 
         //Get an iterator to the start of the list.
         constexpr iterator begin() { return iterator{alloc.resource()}; }
@@ -343,8 +657,8 @@ namespace aggro
     };
 
 
-    template<os_compatible T>
-    inline constexpr std::ostream& operator<<(std::ostream& os, const slist<T>& list)
+    template<os_compatible T, standard_allocator Alloc>
+    inline constexpr std::ostream& operator<<(std::ostream& os, const slist<T, Alloc>& list)
     {
         os << "{ ";
 
@@ -533,10 +847,108 @@ namespace aggro
         allocator_type alloc;
         size_type m_count = 0;
 
+        //Detaches the linked nodes from 'first' to 'last' inclusive. Their own outer links are left stale.
+        constexpr void _unlink(d_node* first, d_node* last)
+        {
+            if(first->prev)
+                first->prev->next = last->next;
+            else
+                alloc.set_head(last->next);
+
+            if(last->next)
+                last->next->prev = first->prev;
+            else
+                alloc.set_tail(first->prev);
+        }
+
+        //Links the chain from 'first' to 'last' inclusive in before 'pos', or at the back when 'pos' is null.
+        constexpr void _link(d_node* pos, d_node* first, d_node* last)
+        {
+            d_node* prev = pos ? pos->prev : alloc.resource_rev();
+
+            first->prev = prev;
+            last->next = pos;
+
+            if(prev)
+                prev->next = first;
+            else
+                alloc.set_head(first);
+
+            if(pos)
+                pos->prev = last;
+            else
+                alloc.set_tail(last);
+        }
+
+        //Rebuilds every prev pointer and the tail of a chain that was relinked through 'next' only.
+        constexpr void _relink_prev(d_node* head)
+        {
+            d_node* prev = nullptr;
+
+            for(d_node* node = head; node; node = node->next)
+            {
+                node->prev = prev;
+                prev = node;
+            }
+
+            alloc.set_head(head);
+            alloc.set_tail(prev);
+        }
+
+        /*
+            Builds a chain of 'count' new nodes holding copies of the values from 'it' onwards. Returns the first
+            node and sets 'last' to the last one. Batch allocators hand out every node in one call, laid out in
+            list order, so walking the chain later runs through memory in sequence.
+        */
+        template<typename Iter>
+        constexpr d_node* _build_chain(Iter it, size_type count, d_node*& last)
+        {
+            last = nullptr;
+            if(count == 0u) return nullptr;
+
+            d_node* first = nullptr;
+
+            if constexpr (batch_allocator<allocator_type>)
+            {
+                first = alloc.allocate_batch(count);
+
+                for(size_type i = 0; i < count; ++i, ++it)
+                {
+                    first[i].prev = (i == 0u) ? nullptr : first + i - 1u;
+                    first[i].next = first + i + 1u;
+                    alloc.construct(first + i, *it);
+                }
+
+                last = first + count - 1u;
+            }
+            else
+            {
+                for(size_type i = 0; i < count; ++i, ++it)
+                {
+                    d_node* node = alloc.allocate(1);
+                    node->prev = last;
+                    alloc.construct(node, *it);
+
+                    if(last)
+                        last->next = node;
+                    else
+                        first = node;
+
+                    last = node;
+                }
+            }
+
+            last->next = nullptr;
+            m_count += count;
+
+            return first;
+        }
+
         template<typename... Args>
         constexpr d_node* _emplace(d_node* spot, Args&&... args)
         {
             d_node* new_node = alloc.allocate(1);
+            new_node->prev = nullptr;
             new_node->next = spot;
             if(spot)
             {
@@ -557,7 +969,7 @@ namespace aggro
                 }
             }
 
-            alloc.construct(new_node, forward<Args>(args)...);
+            alloc.construct(new_node, aggro::forward<Args>(args)...);
             ++m_count;
             
             return new_node;
@@ -569,59 +981,20 @@ namespace aggro
 
         constexpr dlist(const std::initializer_list<T>& init)
         {
-            size_type init_size = init.size();
-            d_node* current = nullptr;
-
-            for(size_type i = 0; i < init_size; ++i)
-            {
-                if(alloc.resource() == nullptr)
-                {
-                    d_node* node = _emplace(nullptr, move(*(init.begin() + i)));
-                    alloc.set_head(node);
-                    alloc.set_tail(node);
-                    current = node;
-                }
-                else
-                {
-                    current->next = _emplace(nullptr, move(*(init.begin() + i)));
-                    alloc.set_tail(current->next);
-                    current = current->next;
-                }
-
-            }
+            append_range(init);
         }
 
         constexpr dlist(const dlist& other)
-        : m_count(other.size())
         {
-            d_node* current = nullptr;
-            
-            for(auto val : other)
-            {
-                if(alloc.resource() == nullptr)
-                {
-                    d_node* node = _emplace(nullptr, val);
-                    alloc.set_head(node);
-                    alloc.set_tail(node);
-                    current = node;
-                }
-                else
-                {
-                    current->next = _emplace(nullptr, val);
-                    alloc.set_tail(current->next);
-                    current = current->next;
-                }
-
-            }
+            append_range(other);
         }
 
+        //Takes the nodes along with the allocator that owns them, so a pool or arena set on 'other' carries over.
         constexpr dlist(dlist&& other)
-        : m_count(other.size())
+        : alloc(move(other.alloc)), m_count(other.m_count)
         {
-            allocator_type* o_all = other.get_allocator();
-            alloc.set_head(o_all->resource());
-            alloc.set_tail(o_all->resource_rev());
-            o_all->unlink();
+            other.alloc.unlink();
+            other.m_count = 0;
         }
 
         constexpr ~dlist() { clear(); }
@@ -684,7 +1057,7 @@ namespace aggro
         template<typename... Args>
         constexpr iterator emplace_front(Args&&... args)
         {
-            alloc.set_head(_emplace(alloc.resource(), forward<Args>(args)...));
+            alloc.set_head(_emplace(alloc.resource(), aggro::forward<Args>(args)...));
             return iterator{ alloc.resource() };
         }
 
@@ -694,11 +1067,11 @@ namespace aggro
         {
             if(empty())
             {
-                return emplace_front(forward<Args>(args)...);
+                return emplace_front(aggro::forward<Args>(args)...);
             }
             else
             {
-                alloc.set_tail(_emplace(nullptr, forward<Args>(args)...));
+                alloc.set_tail(_emplace(nullptr, aggro::forward<Args>(args)...));
                 return iterator{ alloc.resource_rev() };
             }
         }
@@ -737,46 +1110,52 @@ namespace aggro
         constexpr iterator insert(iterator loc, const T& value)
         {
             if(empty()) return emplace_front(move(value));
-            if(loc.get() == nullptr) return iterator { nullptr };
+            if(loc.get() == nullptr) return emplace_back(move(value));
             
             d_node* node = loc.get();
-            d_node* new_node = _emplace(node, value);
+            d_node* new_node = _emplace(node, move(value));
 
-            if(node->prev) node->prev->next = new_node;
-            node->prev = new_node;
+            if(new_node->prev)
+                new_node->prev->next = new_node;
+            else
+                alloc.set_head(new_node);
 
-            return iterator{ node->prev };
+            return iterator{ new_node };
         }
 
         //Insert a value before the specified node location.
         constexpr iterator insert(iterator loc, T&& value)
         {
             if(empty()) return emplace_front(move(value));
-            if(loc.get() == nullptr) return iterator { nullptr };
+            if(loc.get() == nullptr) return emplace_back(move(value));
             
             d_node* node = loc.get();
-            d_node* new_node = _emplace(node, value);
+            d_node* new_node = _emplace(node, move(value));
 
-            if(node->prev) node->prev->next = new_node;
-            node->prev = new_node;
+            if(new_node->prev)
+                new_node->prev->next = new_node;
+            else
+                alloc.set_head(new_node);
 
-            return iterator{ node->prev };
+            return iterator{ new_node };
         }
 
         //Insert a new node at the specified location and construct a new object in place there.
         template<typename... Args>
         constexpr iterator emplace(iterator loc, Args&&... args)
         {
-            if(empty()) return emplace_front(forward<Args>(args)...);
-            if(loc.get() == nullptr) return iterator { nullptr };
+            if(empty()) return emplace_front(aggro::forward<Args>(args)...);
+            if(loc.get() == nullptr) return emplace_back(aggro::forward<Args>(args)...);
             
             d_node* node = loc.get();
-            d_node* new_node = _emplace(node, forward<Args>(args)...);
+            d_node* new_node = _emplace(node, aggro::forward<Args>(args)...);
 
-            if(node->prev) node->prev->next = new_node;
-            node->prev = new_node;
+            if(new_node->prev)
+                new_node->prev->next = new_node;
+            else
+                alloc.set_head(new_node);
 
-            return iterator{ node->prev };
+            return iterator{ new_node };
         }
 
         //Remove the specified node and preserve the link chain.
@@ -788,22 +1167,245 @@ namespace aggro
             if(node_to_delete == nullptr) return;
             
             d_node* prev_node = node_to_delete->prev;
+            d_node* next_node = node_to_delete->next;
 
             if(prev_node)
+                prev_node->next = next_node;
+            else
+                alloc.set_head(next_node);
+
+            if(next_node)
+                next_node->prev = prev_node;
+            else
+                alloc.set_tail(prev_node);
+
+            node_to_delete->~d_node();
+
+            alloc.deallocate(node_to_delete, 1);
+            --m_count;
+        }
+
+        /*
+            Copies every value of 'range' into new nodes before 'pos' and returns the first new node. With a
+            batch allocator all of the nodes come from one allocation.
+        */
+        template<sized_range R>
+        constexpr iterator insert_range(iterator pos, const R& range)
+        {
+            d_node* last = nullptr;
+            d_node* first = _build_chain(range.begin(), static_cast<size_type>(range.size()), last);
+
+            if(first == nullptr) return pos;
+
+            _link(pos.get(), first, last);
+
+            return iterator{ first };
+        }
+
+        //Copies every value of 'range' onto the back of the list.
+        template<sized_range R>
+        constexpr iterator append_range(const R& range)
+        {
+            return insert_range(end(), range);
+        }
+
+        /*
+            Moves the nodes in [first, last) from 'other' to just before 'pos' by relinking them. Nothing is
+            allocated, copied or moved, so iterators and references to the moved values stay valid. O(1) within
+            one list; between lists the moved nodes are walked once to keep both sizes right. 'pos' must not be
+            inside the moved range, and both lists' allocators must be able to free each other's nodes.
+        */
+        constexpr void splice(iterator pos, dlist& other, iterator first, iterator last)
+        {
+            d_node* first_node = first.get();
+            if(first_node == nullptr || first_node == last.get()) return;
+
+            d_node* last_node = last.get() ? last.get()->prev : other.alloc.resource_rev();
+
+            if(&other != this)
             {
-                prev_node->next = node_to_delete->next;
+                size_type moved = 1u;
 
-                if(!prev_node->next) alloc.set_tail(prev_node);
+                for(d_node* node = first_node; node != last_node; node = node->next)
+                    ++moved;
+
+                other.m_count -= moved;
+                m_count += moved;
             }
+
+            other._unlink(first_node, last_node);
+            _link(pos.get(), first_node, last_node);
+        }
+
+        //Moves every node of 'other' to just before 'pos' in O(1).
+        constexpr void splice(iterator pos, dlist& other)
+        {
+            if(&other == this || other.empty()) return;
+
+            _link(pos.get(), other.alloc.resource(), other.alloc.resource_rev());
+            m_count += other.m_count;
+
+            other.m_count = 0;
+            other.alloc.unlink();
+        }
+
+        //Moves the node at 'it' in 'other' to just before 'pos' in O(1).
+        constexpr void splice(iterator pos, dlist& other, iterator it)
+        {
+            d_node* node = it.get();
+            if(node == nullptr) return;
+            if(&other == this && (node == pos.get() || node->next == pos.get())) return;
+
+            other._unlink(node, node);
+            _link(pos.get(), node, node);
+
+            --other.m_count;
+            ++m_count;
+        }
+
+        /*
+            Merges the sorted list 'other' into this sorted list by relinking nodes, leaving 'other' empty.
+            Equal values from this list stay ahead of those from 'other'. Stops walking as soon as one side
+            runs out, so merging a list that sorts after this one only touches the two ends.
+        */
+        template<typename Compare = std::less<>>
+        constexpr void merge(dlist& other, Compare comp = Compare{})
+        {
+            if(&other == this || other.empty()) return;
+
+            d_node* a = alloc.resource();
+            d_node* b = other.alloc.resource();
+            d_node* head = nullptr;
+            d_node* prev = nullptr;
+
+            while(a && b)
+            {
+                d_node* node;
+
+                if(comp(b->value, a->value))
+                {
+                    node = b;
+                    b = b->next;
+                }
+                else
+                {
+                    node = a;
+                    a = a->next;
+                }
+
+                node->prev = prev;
+
+                if(prev)
+                    prev->next = node;
+                else
+                    head = node;
+
+                prev = node;
+            }
+
+            d_node* rest = a ? a : b;
+            d_node* tail = a ? alloc.resource_rev() : other.alloc.resource_rev();
+
+            if(prev)
+                prev->next = rest;
             else
+                head = rest;
+
+            rest->prev = prev;
+
+            alloc.set_head(head);
+            alloc.set_tail(tail);
+            m_count += other.m_count;
+
+            other.m_count = 0;
+            other.alloc.unlink();
+        }
+
+        //Stable in-place merge sort. Relinks the existing nodes and never allocates.
+        template<typename Compare = std::less<>>
+        constexpr void sort(Compare comp = Compare{})
+        {
+            _relink_prev(list_detail::sort_chain(alloc.resource(), comp));
+        }
+
+        //Removes every node equal to the node before it and returns how many were removed.
+        template<typename Predicate = std::equal_to<>>
+        constexpr size_type unique(Predicate pred = Predicate{})
+        {
+            size_type removed = 0u;
+            d_node* node = alloc.resource();
+
+            while(node && node->next)
             {
-                alloc.set_head(node_to_delete->next);
+                d_node* next = node->next;
+
+                if(pred(node->value, next->value))
+                {
+                    node->next = next->next;
+
+                    if(next->next)
+                        next->next->prev = node;
+                    else
+                        alloc.set_tail(node);
+
+                    next->~d_node();
+                    alloc.deallocate(next, 1);
+                    ++removed;
+                }
+                else
+                {
+                    node = next;
+                }
             }
 
-            node_to_delete->~d_node();
+            m_count -= removed;
+            return removed;
+        }
 
-            alloc.deallocate(node_to_delete, 1);
-            --m_count;
+        //Reverses the order of the nodes in place.
+        constexpr void reverse()
+        {
+            d_node* head = alloc.resource();
+            d_node* node = head;
+
+            while(node)
+            {
+                d_node* next = node->next;
+                node->next = node->prev;
+                node->prev = next;
+                node = next;
+            }
+
+            alloc.set_head(alloc.resource_rev());
+            alloc.set_tail(head);
+        }
+
+        /*
+            Moves every value into new nodes laid out in list order and frees the old ones, so later walks run
+            through memory in sequence. A batch allocator hands out all of the new nodes at once; otherwise they
+            are allocated one at a time in list order, which most heaps place close together. Both sets of nodes
+            are held at the peak. Invalidates every iterator and reference. Does nothing if the nodes are
+            already in order.
+        */
+        constexpr void compact()
+        {
+            d_node* old_node = alloc.resource();
+            if(list_detail::is_compact(old_node)) return;
+
+            const size_type count = m_count;
+            d_node* last = nullptr;
+
+            alloc.set_head(_build_chain(list_detail::move_walker<d_node>{ old_node }, count, last));
+            alloc.set_tail(last);
+            m_count = count;
+
+            while(old_node)
+            {
+                d_node* next = old_node->next;
+                old_node->~d_node();
+                alloc.deallocate(old_node, 1);
+                old_node = next;
+            }
         }
 
         //Get the number of nodes currently in the list.
@@ -827,7 +1429,10 @@ namespace aggro
         }
 
         //Get a pointer to the underlying allocator.
-        constexpr allocator_type* get_allocator() const noexcept { return &alloc; }
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
 
         //Get an iterator to the start of the list.
         constexpr iterator begin() { return iterator{alloc.resource()}; }
@@ -848,8 +1453,8 @@ namespace aggro
         }
     };
 
-    template<os_compatible T>
-    inline constexpr std::ostream& operator<<(std::ostream& os, const dlist<T>& list)
+    template<os_compatible T, standard_allocator Alloc>
+    inline constexpr std::ostream& operator<<(std::ostream& os, const dlist<T, Alloc>& list)
     {
         os << "{ ";
 
@@ -1,7 +1,7 @@
 #ifndef OPTIONAL_HPP
 #define OPTIONAL_HPP
 
-#include "concepts/objects.hpp"
+#include "utility.hpp"
 
 namespace aggro
 {
@@ -41,6 +41,9 @@ namespace aggro
         constexpr optional() = default;
         constexpr ~optional() = default;
 
+        constexpr optional(const optional&) = default;
+        constexpr optional(optional&&) noexcept = default;
+
        constexpr optional(const T& value)
         : val(value), value_set(true)
         {}
@@ -71,8 +74,8 @@ namespace aggro
             }
         }
 
-        template<destructible U = value_type>
-        constexpr optional(U&& v) : val(move(v)), value_set(true) {}
+        template<destructible U = value_type> requires (same<std::remove_cvref_t<U>, optional> == false)
+        constexpr optional(U&& v) : val(aggro::forward<U>(v)), value_set(true) {}
 
         constexpr optional& operator=(const optional& other)
         {
@@ -128,7 +131,7 @@ namespace aggro
         {
             reset();
 
-            new(&val) T(std::forward<Args&&>(args)...);
+            new(&val) T(aggro::forward<Args>(args)...);
 
             return val;
         }
@@ -137,7 +140,7 @@ namespace aggro
     template<destructible T, typename... Args>
     inline constexpr optional<T> make_optional(Args&&... args)
     {
-        return optional<T>(T(forward<Args>(args)...));
+        return optional<T>(T(aggro::forward<Args>(args)...));
     }
 
     template<destructible T>
@@ -0,0 +1,308 @@
+#ifndef AGGRO_PARALLEL_HPP
+#define AGGRO_PARALLEL_HPP
+
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "utility.hpp"
+#include "array.hpp"
+#include "job.hpp"
+
+namespace aggro
+{
+    //Controls how a parallel algorithm splits its range.
+    struct parallel_options
+    {
+        std::size_t grain = 0u;             //Elements per chunk. 0 picks a size from the worker count.
+        std::size_t serial_below = 32768u;  //Ranges shorter than this run on the calling thread.
+    };
+
+    namespace parallel_detail
+    {
+        //Most chunks a range is split into. Partial results live on the stack, one cache line each.
+        inline constexpr std::size_t max_chunks = 256u;
+
+        //Chunks per worker when no grain is given, so a slow chunk does not hold up the others for long.
+        inline constexpr std::size_t chunks_per_worker = 4u;
+
+        template<typename T>
+        struct alignas(cache_line_size) padded
+        {
+            T value {};
+        };
+
+        /*
+            Splits [0, count) into chunks whose boundaries fall on cache line boundaries of 'base', so no two
+            chunks write to the same line. Chunk 0 also takes the elements before the first aligned one.
+        */
+        template<typename T>
+        struct chunking
+        {
+            using size_type = std::size_t;
+
+            size_type count = 0u;
+            size_type head = 0u;   //Elements before the first cache line boundary.
+            size_type size = 0u;   //Elements per chunk, a whole number of cache lines where possible.
+            size_type chunks = 1u;
+
+            chunking(const T* base, size_type n, size_type workers, const parallel_options& options)
+                : count(n)
+            {
+                constexpr size_type per_line = (sizeof(T) < cache_line_size && cache_line_size % sizeof(T) == 0u)
+                    ? cache_line_size / sizeof(T) : 1u;
+
+                const size_type misaligned = (reinterpret_cast<std::uintptr_t>(base) % cache_line_size) / sizeof(T);
+                head = (per_line - misaligned % per_line) % per_line;
+
+                if (head >= n)
+                {
+                    head = 0u;
+                    size = n;
+                    return;
+                }
+
+                size = options.grain;
+
+                if (size == 0u)
+                {
+                    const size_type wanted = workers * chunks_per_worker;
+                    size = (n - head + wanted - 1u) / wanted;
+                }
+
+                size = ((size + per_line - 1u) / per_line) * per_line;
+
+                if ((n - head + size - 1u) / size > max_chunks)
+                    size = ((n - head + max_chunks - 1u) / max_chunks + per_line - 1u) / per_line * per_line;
+
+                chunks = (n - head + size - 1u) / size;
+            }
+
+            size_type begin(size_type chunk) const { return chunk == 0u ? 0u : head + chunk * size; }
+
+            size_type end(size_type chunk) const
+            {
+                const size_type last = head + (chunk + 1u) * size;
+                return last < count ? last : count;
+            }
+        };
+
+        //Runs body(chunk) for every chunk. The calling thread takes chunk 0 and then helps with the rest.
+        template<typename Body>
+        void run_chunks(job_system& jobs, std::size_t chunks, Body& body)
+        {
+            job_counter counter;
+
+            for (std::size_t i = 1u; i < chunks; i++)
+                jobs.submit([&body, i] { body(i); }, counter);
+
+            body(0u);
+            jobs.wait(counter);
+        }
+
+        inline bool serial(std::size_t count, const job_system& jobs, const parallel_options& options)
+        {
+            return count < options.serial_below || jobs.worker_count() < 2u;
+        }
+
+    } // namespace parallel_detail
+
+    /*
+        Calls f(element) for every element of [first, last), split into chunks across the job system. 'f' is
+        called concurrently from several threads and must not depend on the order it sees elements in.
+    */
+    template<typename T, typename F>
+    void parallel_for_each(job_system& jobs, T* first, T* last, F f, const parallel_options& options = {})
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+
+        if (parallel_detail::serial(count, jobs, options))
+        {
+            for (; first != last; ++first)
+                f(*first);
+
+            return;
+        }
+
+        const parallel_detail::chunking<T> plan(first, count, jobs.worker_count(), options);
+
+        auto body = [&](std::size_t chunk)
+        {
+            T* end = first + plan.end(chunk);
+
+            for (T* it = first + plan.begin(chunk); it != end; ++it)
+                f(*it);
+        };
+
+        parallel_detail::run_chunks(jobs, plan.chunks, body);
+    }
+
+    template<contiguous_container Container, typename F>
+    void parallel_for_each(job_system& jobs, Container& container, F f, const parallel_options& options = {})
+    {
+        parallel_for_each(jobs, container.data(), container.data() + container.size(), f, options);
+    }
+
+    /*
+        Writes f(first[i]) to out[i] for every element of [first, last). 'out' may be 'first'. Chunks are cut
+        on cache line boundaries of 'out', so no two threads write to the same line.
+    */
+    template<typename T, typename U, typename F>
+    void parallel_transform(job_system& jobs, const T* first, const T* last, U* out, F f, const parallel_options& options = {})
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+
+        if (parallel_detail::serial(count, jobs, options))
+        {
+            for (std::size_t i = 0; i < count; i++)
+                out[i] = f(first[i]);
+
+            return;
+        }
+
+        const parallel_detail::chunking<U> plan(out, count, jobs.worker_count(), options);
+
+        auto body = [&](std::size_t chunk)
+        {
+            const std::size_t end = plan.end(chunk);
+
+            for (std::size_t i = plan.begin(chunk); i < end; i++)
+                out[i] = f(first[i]);
+        };
+
+        parallel_detail::run_chunks(jobs, plan.chunks, body);
+    }
+
+    //Transforms every element of 'in' into 'out', which must hold at least in.size() elements.
+    template<contiguous_container In, contiguous_container Out, typename F>
+    void parallel_transform(job_system& jobs, const In& in, Out& out, F f, const parallel_options& options = {})
+    {
+        parallel_transform(jobs, in.data(), in.data() + in.size(), out.data(), f, options);
+    }
+
+    /*
+        Folds [first, last) into 'init' with 'op'. Each chunk is folded on its own and the partial results are
+        combined in chunk order, so 'op' must be associative but need not be commutative.
+    */
+    template<default_constructible T, typename Op = std::plus<T>>
+    T parallel_reduce(job_system& jobs, const T* first, const T* last, std::type_identity_t<T> init, Op op = Op{},
+        const parallel_options& options = {})
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+
+        if (parallel_detail::serial(count, jobs, options))
+        {
+            for (; first != last; ++first)
+                init = op(init, *first);
+
+            return init;
+        }
+
+        const parallel_detail::chunking<T> plan(first, count, jobs.worker_count(), options);
+        array<parallel_detail::padded<T>, parallel_detail::max_chunks> partials;
+
+        auto body = [&](std::size_t chunk)
+        {
+            const T* it = first + plan.begin(chunk);
+            const T* end = first + plan.end(chunk);
+
+            T sum = *it;
+
+            for (++it; it != end; ++it)
+                sum = op(sum, *it);
+
+            partials[chunk].value = move(sum);
+        };
+
+        parallel_detail::run_chunks(jobs, plan.chunks, body);
+
+        for (std::size_t i = 0; i < plan.chunks; i++)
+            init = op(init, partials[i].value);
+
+        return init;
+    }
+
+    template<contiguous_container Container, typename Op = std::plus<container_value_t<Container>>>
+    container_value_t<Container> parallel_reduce(job_system& jobs, const Container& container, container_value_t<Container> init,
+        Op op = Op{}, const parallel_options& options = {})
+    {
+        return parallel_reduce(jobs, container.data(), container.data() + container.size(), init, op, options);
+    }
+
+    /*
+        Writes the running fold of [first, last) to 'out', so out[i] = first[0] op ... op first[i]. 'out' may be
+        'first'. Runs in two passes: every chunk is folded to find its starting offset, then every chunk is
+        scanned from that offset, so it reads the input twice. 'op' must be associative.
+    */
+    template<default_constructible T, typename Op = std::plus<T>>
+    void parallel_inclusive_scan(job_system& jobs, const T* first, const T* last, T* out, Op op = Op{},
+        const parallel_options& options = {})
+    {
+        const std::size_t count = static_cast<std::size_t>(last - first);
+
+        if (count == 0u) return;
+
+        if (parallel_detail::serial(count, jobs, options))
+        {
+            T sum = first[0];
+            out[0] = sum;
+
+            for (std::size_t i = 1u; i < count; i++)
+            {
+                sum = op(sum, first[i]);
+                out[i] = sum;
+            }
+
+            return;
+        }
+
+        const parallel_detail::chunking<T> plan(out, count, jobs.worker_count(), options);
+        array<parallel_detail::padded<T>, parallel_detail::max_chunks> offsets;
+
+        //Pass 1: fold every chunk but the last, whose total nobody needs.
+        auto fold = [&](std::size_t chunk)
+        {
+            const std::size_t end = plan.end(chunk);
+            T sum = first[plan.begin(chunk)];
+
+            for (std::size_t i = plan.begin(chunk) + 1u; i < end; i++)
+                sum = op(sum, first[i]);
+
+            offsets[chunk].value = move(sum);
+        };
+
+        parallel_detail::run_chunks(jobs, plan.chunks - 1u, fold);
+
+        //Turn the chunk totals into the fold of everything before each chunk.
+        for (std::size_t i = 1u; i + 1u < plan.chunks; i++)
+            offsets[i].value = op(offsets[i - 1u].value, offsets[i].value);
+
+        //Pass 2: scan every chunk, starting from the total of the chunks before it.
+        auto scan = [&](std::size_t chunk)
+        {
+            const std::size_t end = plan.end(chunk);
+            std::size_t i = plan.begin(chunk);
+
+            T sum = (chunk == 0u) ? first[i] : op(offsets[chunk - 1u].value, first[i]);
+            out[i] = sum;
+
+            for (++i; i < end; i++)
+            {
+                sum = op(sum, first[i]);
+                out[i] = sum;
+            }
+        };
+
+        parallel_detail::run_chunks(jobs, plan.chunks, scan);
+    }
+
+    //Scans 'in' into 'out', which must hold at least in.size() elements.
+    template<contiguous_container In, contiguous_container Out, typename Op = std::plus<container_value_t<Out>>>
+    void parallel_inclusive_scan(job_system& jobs, const In& in, Out& out, Op op = Op{}, const parallel_options& options = {})
+    {
+        parallel_inclusive_scan(jobs, in.data(), in.data() + in.size(), out.data(), op, options);
+    }
+
+} // namespace aggro
+
+#endif // AGGRO_PARALLEL_HPP
@@ -0,0 +1,209 @@
+#ifndef AGGRO_PRIORITY_QUEUE_HPP
+#define AGGRO_PRIORITY_QUEUE_HPP
+
+#include <functional>
+#include <iterator>
+#include "array.hpp"
+
+namespace aggro
+{
+    /*
+        A priority queue kept as an implicit d-ary heap in a darray. With Compare = std::less the largest element
+        is on top, as with std::priority_queue. Each node has 'Arity' children, so a wider heap is shallower and
+        sifting down touches fewer cache lines; 4 is a good default. Elements are moved into a hole while sifting
+        instead of being swapped. pop() returns an empty optional when the queue is empty.
+    */
+    template<typename T, typename Compare = std::less<T>, std::size_t Arity = 4u, standard_allocator Alloc = std_contiguous_allocator<T>>
+    class priority_queue
+    {
+        static_assert(Arity >= 2u, "A heap node needs at least two children.");
+
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using allocator_type = Alloc;
+
+        static constexpr size_type arity = Arity;
+
+    private:
+        darray<T, Alloc> m_heap;
+        [[no_unique_address]] Compare m_less;
+
+        //Moves the element at 'index' up until its parent is not less than it.
+        constexpr void sift_up(size_type index)
+        {
+            T value = move(m_heap[index]);
+
+            while (index > 0u)
+            {
+                const size_type parent = (index - 1u) / Arity;
+
+                if (!m_less(m_heap[parent], value)) break;
+
+                m_heap[index] = move(m_heap[parent]);
+                index = parent;
+            }
+
+            m_heap[index] = move(value);
+        }
+
+        //Moves the element at 'index' down until none of its children is greater than it.
+        constexpr void sift_down(size_type index)
+        {
+            const size_type count = m_heap.size();
+            T value = move(m_heap[index]);
+
+            while (true)
+            {
+                const size_type first = index * Arity + 1u;
+                if (first >= count) break;
+
+                const size_type last = (first + Arity < count) ? first + Arity : count;
+                size_type best = first;
+
+                for (size_type child = first + 1u; child < last; child++)
+                    if (m_less(m_heap[best], m_heap[child])) best = child;
+
+                if (!m_less(value, m_heap[best])) break;
+
+                m_heap[index] = move(m_heap[best]);
+                index = best;
+            }
+
+            m_heap[index] = move(value);
+        }
+
+        //Restores the heap property over the whole array bottom-up in O(n).
+        constexpr void heapify()
+        {
+            const size_type count = m_heap.size();
+            if (count < 2u) return;
+
+            for (size_type i = (count - 2u) / Arity + 1u; i > 0u; i--)
+                sift_down(i - 1u);
+        }
+
+        //Removes the top by walking the hole at the root down to a leaf along the greater children, then
+        //dropping the last element into it and sifting that up. The last element almost always belongs near
+        //the bottom, so this saves a comparison per level over a plain sift down.
+        constexpr void pop_root()
+        {
+            const size_type count = m_heap.size() - 1u;
+            size_type index = 0u;
+
+            while (true)
+            {
+                const size_type first = index * Arity + 1u;
+                if (first >= count) break;
+
+                const size_type last = (first + Arity < count) ? first + Arity : count;
+                size_type best = first;
+
+                for (size_type child = first + 1u; child < last; child++)
+                    if (m_less(m_heap[best], m_heap[child])) best = child;
+
+                m_heap[index] = move(m_heap[best]);
+                index = best;
+            }
+
+            if (index != count)
+            {
+                m_heap[index] = move(m_heap[count]);
+                sift_up(index);
+            }
+
+            m_heap.pop_back();
+        }
+
+    public:
+        constexpr priority_queue()
+        {
+            m_heap.expand_factor = 2.0f;
+        }
+
+        constexpr explicit priority_queue(const Compare& compare)
+            : m_less(compare)
+        {
+            m_heap.expand_factor = 2.0f;
+        }
+
+        template<typename... Args>
+        constexpr void emplace(Args&&... args)
+        {
+            m_heap.emplace_back(aggro::forward<Args>(args)...);
+            sift_up(m_heap.size() - 1u);
+        }
+
+        constexpr void push(const T& value) { emplace(value); }
+        constexpr void push(T&& value) { emplace(move(value)); }
+
+        /*
+            Adds every element in [first, last). When the range is larger than the queue already is, the whole
+            array is re-heapified once in O(n); otherwise each new element is sifted up on its own.
+        */
+        template<typename InputIt>
+        constexpr void push_range(InputIt first, InputIt last)
+        {
+            const size_type old_size = m_heap.size();
+
+            if constexpr (std::forward_iterator<InputIt>)
+                reserve(old_size + static_cast<size_type>(std::distance(first, last)));
+
+            for (; first != last; ++first)
+                m_heap.emplace_back(*first);
+
+            const size_type added = m_heap.size() - old_size;
+
+            if (added > old_size)
+            {
+                heapify();
+            }
+            else
+            {
+                for (size_type i = old_size; i < m_heap.size(); i++)
+                    sift_up(i);
+            }
+        }
+
+        //Removes the top element and returns it, or an empty optional if the queue is empty.
+        [[nodiscard]] constexpr optional<T> pop()
+        {
+            if (m_heap.empty()) return optional<T>();
+
+            optional<T> result(move(m_heap[0]));
+            pop_root();
+
+            return result;
+        }
+
+        //Returns an optional reference to the top element.
+        constexpr aggro::optional_ref<const T> top() const
+        {
+            if (!m_heap.empty())
+                return m_heap[0];
+            else
+                return aggro::nullopt_ref_t<const T>();
+        }
+
+        constexpr void reserve(size_type cap)
+        {
+            if (cap > m_heap.capacity()) m_heap.reserve(cap);
+        }
+
+        constexpr void clear() { m_heap.clear(); }
+
+        constexpr size_type size() const { return m_heap.size(); }
+        constexpr size_type capacity() const { return m_heap.capacity(); }
+
+        [[nodiscard("This function does not empty the queue.")]] constexpr bool empty() const { return m_heap.empty(); }
+
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return m_heap.get_allocator(); }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return m_heap.get_allocator(); }
+    };
+
+} // namespace aggro
+
+#endif // AGGRO_PRIORITY_QUEUE_HPP
@@ -2,40 +2,194 @@
 #define MEM_PROFILE_HPP
 #include <iostream>
 #include <chrono>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <new>
 
 namespace aggro
 {
+    //Number of power-of-two size classes in the allocation histogram. Class 0 counts requests of up to
+    //8 bytes, class n counts requests of up to 8 << n bytes, and the last class counts everything larger.
+    inline constexpr std::size_t heap_size_classes = 16u;
+
+    //A merged view of heap activity.
+    struct heap_stats
+    {
+        std::size_t bytes_allocated = 0u;
+        std::size_t bytes_deallocated = 0u;
+        std::ptrdiff_t live = 0;    //Bytes allocated minus bytes deallocated.
+        std::ptrdiff_t peak = 0;    //Highest live value seen. When merged, the sum of the per-thread peaks.
+        std::size_t allocations = 0u;
+        std::size_t deallocations = 0u;
+        std::size_t histogram[heap_size_classes] = {};
+    };
+
     /*
         This struct is used to keep track of memory allocations and deallocations in order to detect memory leaks.
         All test functions in the test suite require you to pass in an object of type head_counter and execute it
         via the macro MEM_CHECK.
+
+        Every thread counts into its own record, so allocating threads never contend on a shared counter. Records
+        are linked into a global list the first time a thread allocates and are never freed, so totals() still
+        includes threads that have exited. Memory freed on a different thread than it was allocated on shows up as
+        negative live bytes on the freeing thread; the merged totals are exact.
     */
     struct heap_counter
     {
-        inline static size_t mem_alloc = 0u;
-        inline static size_t mem_delete = 0u;
+    private:
+        //Counters written only by the owning thread. They are atomic so totals() may read them at any time.
+        struct thread_record
+        {
+            std::atomic<std::size_t> bytes_allocated{ 0u };
+            std::atomic<std::size_t> bytes_deallocated{ 0u };
+            std::atomic<std::ptrdiff_t> live{ 0 };
+            std::atomic<std::ptrdiff_t> peak{ 0 };
+            std::atomic<std::size_t> allocations{ 0u };
+            std::atomic<std::size_t> deallocations{ 0u };
+            std::atomic<std::size_t> histogram[heap_size_classes] = {};
+            thread_record* next = nullptr;
+        };
+
+        inline static std::atomic<thread_record*> records{ nullptr };
+        inline static thread_local thread_record* local_record = nullptr;
+
+        heap_stats m_start;
+        std::ptrdiff_t m_start_live = 0; //Live bytes of the constructing thread.
+
+        //Single-writer increment. Cheaper than fetch_add because no other thread writes the counter.
+        template<typename T>
+        static void bump(std::atomic<T>& counter, T amount)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        //The calling thread's record. Created with malloc so it never recurses into operator new.
+        static thread_record& local()
+        {
+            if (local_record == nullptr)
+            {
+                void* spot = std::malloc(sizeof(thread_record));
+                if (spot == nullptr) std::abort();
+
+                thread_record* record = new(spot) thread_record();
+                record->next = records.load(std::memory_order_relaxed);
+
+                while (!records.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed));
+
+                local_record = record;
+            }
+
+            return *local_record;
+        }
+
+        static heap_stats read(const thread_record& record)
+        {
+            heap_stats stats;
+            stats.bytes_allocated = record.bytes_allocated.load(std::memory_order_relaxed);
+            stats.bytes_deallocated = record.bytes_deallocated.load(std::memory_order_relaxed);
+            stats.live = record.live.load(std::memory_order_relaxed);
+            stats.peak = record.peak.load(std::memory_order_relaxed);
+            stats.allocations = record.allocations.load(std::memory_order_relaxed);
+            stats.deallocations = record.deallocations.load(std::memory_order_relaxed);
+
+            for (std::size_t i = 0; i < heap_size_classes; i++)
+                stats.histogram[i] = record.histogram[i].load(std::memory_order_relaxed);
 
-        inline static void add(size_t bytes)
+            return stats;
+        }
+
+    public:
+        //Size class a request of 'bytes' falls into.
+        static constexpr std::size_t size_class(std::size_t bytes)
         {
-            mem_alloc += bytes;
+            if (bytes <= 8u) return 0u;
+
+            const std::size_t cls = static_cast<std::size_t>(std::bit_width(bytes - 1u)) - 3u;
+            return (cls < heap_size_classes) ? cls : heap_size_classes - 1u;
         }
 
-        inline static void remove(size_t bytes)
+        //Records an allocation of 'bytes' on the calling thread.
+        static void add(std::size_t bytes)
         {
-            mem_delete += bytes;
+            thread_record& record = local();
+            const std::ptrdiff_t live = record.live.load(std::memory_order_relaxed) + static_cast<std::ptrdiff_t>(bytes);
+
+            bump(record.bytes_allocated, bytes);
+            bump(record.allocations, std::size_t(1u));
+            bump(record.histogram[size_class(bytes)], std::size_t(1u));
+            record.live.store(live, std::memory_order_relaxed);
+
+            if (live > record.peak.load(std::memory_order_relaxed))
+                record.peak.store(live, std::memory_order_relaxed);
+        }
+
+        //Records a deallocation of 'bytes' on the calling thread.
+        static void remove(std::size_t bytes)
+        {
+            thread_record& record = local();
+
+            bump(record.bytes_deallocated, bytes);
+            bump(record.deallocations, std::size_t(1u));
+            bump(record.live, -static_cast<std::ptrdiff_t>(bytes));
+        }
+
+        //Counters of the calling thread.
+        static heap_stats thread_totals() { return read(local()); }
+
+        //Counters of every thread that has allocated so far, merged.
+        static heap_stats totals()
+        {
+            heap_stats merged;
+
+            for (thread_record* record = records.load(std::memory_order_acquire); record; record = record->next)
+            {
+                const heap_stats stats = read(*record);
+
+                merged.bytes_allocated += stats.bytes_allocated;
+                merged.bytes_deallocated += stats.bytes_deallocated;
+                merged.live += stats.live;
+                merged.peak += stats.peak;
+                merged.allocations += stats.allocations;
+                merged.deallocations += stats.deallocations;
+
+                for (std::size_t i = 0; i < heap_size_classes; i++)
+                    merged.histogram[i] += stats.histogram[i];
+            }
+
+            return merged;
+        }
+
+        //Restarts peak tracking for the calling thread from its current live bytes.
+        static void reset_peak()
+        {
+            thread_record& record = local();
+            record.peak.store(record.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        heap_counter()
+        {
+            reset_peak();
+            m_start = totals();
+            m_start_live = thread_totals().live;
         }
 
-        heap_counter() = default;
         ~heap_counter()
         {
-            std::cout << mem_alloc << " bytes of memory allocated.\n" << mem_delete << " bytes deallocated.\n\n";
-            mem_alloc = 0u;
-            mem_delete = 0u;
+            const heap_stats now = totals();
+
+            std::cout << now.bytes_allocated - m_start.bytes_allocated << " bytes of memory allocated.\n"
+                << now.bytes_deallocated - m_start.bytes_deallocated << " bytes deallocated.\n"
+                << now.allocations - m_start.allocations << " allocations, peak of "
+                << thread_totals().peak - m_start_live << " bytes live.\n\n";
         }
     };
 
     /*
         This struct times a function. By comparing speed with the STL we can determine how well, or poorly, our code is optimized.
+        For numbers stable enough to act on, write a case for the aggro_bench target instead (see bench.hpp).
     */
     struct bench_timer
     {
@@ -52,44 +206,128 @@ namespace aggro
         }
     };
 
+    namespace profile_detail
+    {
+        //Every profiled block starts with this header so any delete overload can recover the
+        //request size and the pointer malloc returned, whatever alignment was asked for.
+        struct block_header
+        {
+            void* base;
+            std::size_t size;
+        };
+
+        static_assert(sizeof(block_header) <= alignof(std::max_align_t), "The header must fit in the alignment padding.");
+
+        inline void* allocate(std::size_t size, std::size_t align) noexcept
+        {
+            if (align < alignof(std::max_align_t)) align = alignof(std::max_align_t);
+
+            unsigned char* base = static_cast<unsigned char*>(std::malloc(size + align + sizeof(block_header)));
+            if (base == nullptr) return nullptr;
+
+            const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(base) + sizeof(block_header);
+            unsigned char* user = base + (((addr + align - 1u) & ~(std::uintptr_t)(align - 1u)) - reinterpret_cast<std::uintptr_t>(base));
+
+            block_header* header = reinterpret_cast<block_header*>(user) - 1;
+            header->base = base;
+            header->size = size;
+
+            heap_counter::add(size);
+            return user;
+        }
+
+        inline void deallocate(void* ptr) noexcept
+        {
+            if (ptr == nullptr) return;
+
+            block_header* header = static_cast<block_header*>(ptr) - 1;
+
+            heap_counter::remove(header->size);
+            std::free(header->base);
+        }
+
+        inline void* allocate_or_throw(std::size_t size, std::size_t align)
+        {
+            void* ptr = allocate(size, align);
+            if (ptr == nullptr) throw std::bad_alloc();
+
+            return ptr;
+        }
+    } // namespace profile_detail
+
 } // namespace aggro
 
 #ifdef AGGRO_MEMORY_PROFILE
 /*
-    Override global new and delete operators.
+    Override global new and delete operators. Every form goes through the same header, so plain, sized,
+    aligned and nothrow overloads can be mixed freely and all of them are counted.
 */
 
 [[nodiscard]] inline void* operator new(size_t size)  //Global single object
 {
-    aggro::heap_counter::add(size);
-    return malloc(size);
+    return aggro::profile_detail::allocate_or_throw(size, 0u);
 }
 
 [[nodiscard]] inline void* operator new[](size_t size)    //Global object array
 {
-    aggro::heap_counter::add(size);
-    return malloc(size);
+    return aggro::profile_detail::allocate_or_throw(size, 0u);
+}
+
+[[nodiscard]] inline void* operator new(size_t size, std::align_val_t align)
+{
+    return aggro::profile_detail::allocate_or_throw(size, static_cast<size_t>(align));
+}
+
+[[nodiscard]] inline void* operator new[](size_t size, std::align_val_t align)
+{
+    return aggro::profile_detail::allocate_or_throw(size, static_cast<size_t>(align));
+}
+
+[[nodiscard]] inline void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return aggro::profile_detail::allocate(size, 0u);
 }
 
-inline void operator delete(void* ptr, size_t size) //Global single object delete
+[[nodiscard]] inline void* operator new[](size_t size, const std::nothrow_t&) noexcept
 {
-    aggro::heap_counter::remove(size);
-    free(ptr);
+    return aggro::profile_detail::allocate(size, 0u);
 }
 
-inline void operator delete[](void* ptr, size_t size)   //Global object array delete
+[[nodiscard]] inline void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
 {
-    aggro::heap_counter::remove(size);
-    free(ptr);
+    return aggro::profile_detail::allocate(size, static_cast<size_t>(align));
 }
 
+[[nodiscard]] inline void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return aggro::profile_detail::allocate(size, static_cast<size_t>(align));
+}
+
+inline void operator delete(void* ptr) noexcept { aggro::profile_detail::deallocate(ptr); }
+inline void operator delete[](void* ptr) noexcept { aggro::profile_detail::deallocate(ptr); }
+
+inline void operator delete(void* ptr, size_t) noexcept { aggro::profile_detail::deallocate(ptr); } //Global single object delete
+inline void operator delete[](void* ptr, size_t) noexcept { aggro::profile_detail::deallocate(ptr); } //Global object array delete
+
+inline void operator delete(void* ptr, std::align_val_t) noexcept { aggro::profile_detail::deallocate(ptr); }
+inline void operator delete[](void* ptr, std::align_val_t) noexcept { aggro::profile_detail::deallocate(ptr); }
+
+inline void operator delete(void* ptr, size_t, std::align_val_t) noexcept { aggro::profile_detail::deallocate(ptr); }
+inline void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { aggro::profile_detail::deallocate(ptr); }
+
+inline void operator delete(void* ptr, const std::nothrow_t&) noexcept { aggro::profile_detail::deallocate(ptr); }
+inline void operator delete[](void* ptr, const std::nothrow_t&) noexcept { aggro::profile_detail::deallocate(ptr); }
+
+inline void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { aggro::profile_detail::deallocate(ptr); }
+inline void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { aggro::profile_detail::deallocate(ptr); }
+
 #define MEM_CHECK(func) \
 std::cout << "Function name " << #func << ":\n";\
 func(aggro::bench_timer(), aggro::heap_counter());
 
 #else
-#define MEM_CHECK(func) 
+#define MEM_CHECK(func)
 
 #endif //AGGRO_MEMORY_PROFILE
 
-#endif // MEM_PROFILE_HPP
\ No newline at end of file
+#endif // MEM_PROFILE_HPP
@@ -0,0 +1,330 @@
+#ifndef AGGRO_QUEUE_HPP
+#define AGGRO_QUEUE_HPP
+
+#include <atomic>
+#include "utility.hpp"
+#include "optional.hpp"
+#include "array.hpp"
+#include "allocators/standard.hpp"
+
+namespace aggro
+{
+    /*
+        A fixed-capacity ring buffer for passing values from exactly one producer thread to exactly one
+        consumer thread without locks. Storage is an aggro::array of N slots, so nothing is allocated
+        after construction and no function throws. The producer and consumer indices live on separate
+        cache lines, and each side keeps a cached copy of the other side's index so the shared
+        cache lines are only touched when the ring looks full or empty.
+    */
+    template<default_constructible T, std::size_t N>
+    class spsc_ring
+    {
+        static_assert(N > 0u, "An spsc_ring needs at least one slot.");
+
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+
+    private:
+        struct alignas(cache_line_size) producer_side
+        {
+            std::atomic<size_type> tail { 0u }; //Next slot to write. Only the producer stores to it.
+            size_type head_cache = 0u;          //Producer's last view of the consumer's head.
+        };
+
+        struct alignas(cache_line_size) consumer_side
+        {
+            std::atomic<size_type> head { 0u }; //Next slot to read. Only the consumer stores to it.
+            size_type tail_cache = 0u;          //Consumer's last view of the producer's tail.
+        };
+
+        producer_side m_producer;
+        consumer_side m_consumer;
+        alignas(cache_line_size) array<T, N> m_slots;
+
+    public:
+        constexpr spsc_ring() = default;
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+
+        //Construct a value in the next free slot. Returns false if the ring is full.
+        //Producer thread only.
+        template<typename... Args>
+        [[nodiscard]] bool try_emplace(Args&&... args)
+        {
+            const size_type tail = m_producer.tail.load(std::memory_order_relaxed);
+
+            if (tail - m_producer.head_cache == N)
+            {
+                m_producer.head_cache = m_consumer.head.load(std::memory_order_acquire);
+
+                if (tail - m_producer.head_cache == N) return false;
+            }
+
+            m_slots[tail % N] = T(aggro::forward<Args>(args)...);
+            m_producer.tail.store(tail + 1u, std::memory_order_release);
+
+            return true;
+        }
+
+        //Copy a value into the ring. Returns false if the ring is full.
+        //Producer thread only.
+        [[nodiscard]] bool try_push(const T& value) { return try_emplace(value); }
+
+        //Move a value into the ring. Returns false if the ring is full, in which case 'value' is untouched.
+        //Producer thread only.
+        [[nodiscard]] bool try_push(T&& value) { return try_emplace(move(value)); }
+
+        //Take the oldest value out of the ring, or an empty optional if there is nothing to take.
+        //Consumer thread only.
+        [[nodiscard]] optional<T> try_pop()
+        {
+            const size_type head = m_consumer.head.load(std::memory_order_relaxed);
+
+            if (head == m_consumer.tail_cache)
+            {
+                m_consumer.tail_cache = m_producer.tail.load(std::memory_order_acquire);
+
+                if (head == m_consumer.tail_cache) return optional<T>();
+            }
+
+            optional<T> result(move(m_slots[head % N]));
+            m_consumer.head.store(head + 1u, std::memory_order_release);
+
+            return result;
+        }
+
+        //Approximate number of values waiting. Exact only when neither side is active.
+        size_type size() const
+        {
+            const size_type tail = m_producer.tail.load(std::memory_order_acquire);
+            const size_type head = m_consumer.head.load(std::memory_order_acquire);
+
+            return (tail > head) ? tail - head : 0u;
+        }
+
+        [[nodiscard("This function does not empty the ring.")]] bool empty() const { return size() == 0u; }
+
+        constexpr size_type capacity() const { return N; }
+    };
+
+    //A slot in an mpmc_queue. The sequence number says whose turn it is to use the slot.
+    template<typename T>
+    struct mpmc_slot
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        constexpr mpmc_slot(std::size_t seq) : sequence(seq) {}
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    /*
+        A bounded queue that any number of threads can push to and pop from without locks. Every slot carries its
+        own sequence number, so producers and consumers only contend on the two position counters and never on
+        each other's slots. The slot array is one allocation from Alloc, made when the queue is constructed;
+        the capacity is rounded up to a power of two. push_n and pop_n claim several consecutive slots with a
+        single compare-exchange.
+    */
+    template<typename T, standard_allocator Alloc = std_contiguous_allocator<mpmc_slot<T>>>
+    class mpmc_queue
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using allocator_type = Alloc;
+
+    private:
+        using slot = mpmc_slot<T>;
+
+        allocator_type alloc;
+        size_type m_mask = 0u;
+
+        alignas(cache_line_size) std::atomic<size_type> m_enqueue { 0u };
+        alignas(cache_line_size) std::atomic<size_type> m_dequeue { 0u };
+
+        slot* slots() const { return alloc.resource(); }
+
+        //Claims up to 'max' consecutive slots starting at the position counter 'pos'. A slot is ready when its
+        //sequence equals its position plus 'lag'. Returns the first claimed position and sets 'max' to the number claimed.
+        size_type claim(std::atomic<size_type>& counter, size_type lag, size_type& max)
+        {
+            size_type pos = counter.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                size_type ready = 0u;
+
+                while (ready < max && ready <= m_mask &&
+                    slots()[(pos + ready) & m_mask].sequence.load(std::memory_order_acquire) == pos + ready + lag)
+                {
+                    ++ready;
+                }
+
+                if (ready == 0u)
+                {
+                    const size_type seq = slots()[pos & m_mask].sequence.load(std::memory_order_acquire);
+
+                    //The slot still belongs to the previous lap, so the queue is full or empty.
+                    if (static_cast<std::ptrdiff_t>(seq - (pos + lag)) < 0)
+                    {
+                        max = 0u;
+                        return pos;
+                    }
+
+                    pos = counter.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (counter.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed))
+                {
+                    max = ready;
+                    return pos;
+                }
+            }
+        }
+
+    public:
+        //Allocates room for at least 'capacity' values, rounded up to a power of two.
+        explicit mpmc_queue(size_type capacity)
+        {
+            size_type cap = 2u;
+            while (cap < capacity) cap *= 2u;
+
+            m_mask = cap - 1u;
+            alloc.set_res(alloc.allocate(cap));
+
+            for (size_type i = 0; i < cap; i++)
+                alloc.construct(&alloc.resource()[i], i);
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        ~mpmc_queue()
+        {
+            const size_type end = m_enqueue.load(std::memory_order_relaxed);
+
+            for (size_type pos = m_dequeue.load(std::memory_order_relaxed); pos != end; pos++)
+                slots()[pos & m_mask].value()->~T();
+
+            for (size_type i = 0; i <= m_mask; i++)
+                slots()[i].~slot();
+
+            alloc.deallocate(alloc.resource(), m_mask + 1u);
+        }
+
+        //Construct a value in the queue. Returns false if the queue is full.
+        template<typename... Args>
+        [[nodiscard]] bool try_emplace(Args&&... args)
+        {
+            size_type count = 1u;
+            const size_type pos = claim(m_enqueue, 0u, count);
+
+            if (count == 0u) return false;
+
+            slot& spot = slots()[pos & m_mask];
+            new(spot.value()) T(aggro::forward<Args>(args)...);
+            spot.sequence.store(pos + 1u, std::memory_order_release);
+
+            return true;
+        }
+
+        //Copy a value into the queue. Returns false if the queue is full.
+        [[nodiscard]] bool try_push(const T& value) { return try_emplace(value); }
+
+        //Move a value into the queue. Returns false if the queue is full, in which case 'value' is untouched.
+        [[nodiscard]] bool try_push(T&& value) { return try_emplace(move(value)); }
+
+        //Take the oldest value out of the queue, or an empty optional if there is nothing to take.
+        [[nodiscard]] optional<T> try_pop()
+        {
+            size_type count = 1u;
+            const size_type pos = claim(m_dequeue, 1u, count);
+
+            if (count == 0u) return optional<T>();
+
+            slot& spot = slots()[pos & m_mask];
+            optional<T> result(move(*spot.value()));
+            spot.value()->~T();
+            spot.sequence.store(pos + m_mask + 1u, std::memory_order_release);
+
+            return result;
+        }
+
+        //Copies up to 'count' values starting at 'first' into the queue. Returns how many were pushed.
+        template<typename InputIt>
+        size_type push_n(InputIt first, size_type count)
+        {
+            size_type pushed = 0u;
+
+            while (pushed < count)
+            {
+                size_type claimed = count - pushed;
+                const size_type pos = claim(m_enqueue, 0u, claimed);
+
+                if (claimed == 0u) break;
+
+                for (size_type i = 0; i < claimed; i++, ++first)
+                {
+                    slot& spot = slots()[(pos + i) & m_mask];
+                    new(spot.value()) T(*first);
+                    spot.sequence.store(pos + i + 1u, std::memory_order_release);
+                }
+
+                pushed += claimed;
+            }
+
+            return pushed;
+        }
+
+        //Moves up to 'count' values out of the queue and assigns them through 'out'. Returns how many were popped.
+        template<typename OutputIt>
+        size_type pop_n(OutputIt out, size_type count)
+        {
+            size_type popped = 0u;
+
+            while (popped < count)
+            {
+                size_type claimed = count - popped;
+                const size_type pos = claim(m_dequeue, 1u, claimed);
+
+                if (claimed == 0u) break;
+
+                for (size_type i = 0; i < claimed; i++, ++out)
+                {
+                    slot& spot = slots()[(pos + i) & m_mask];
+                    *out = move(*spot.value());
+                    spot.value()->~T();
+                    spot.sequence.store(pos + i + m_mask + 1u, std::memory_order_release);
+                }
+
+                popped += claimed;
+            }
+
+            return popped;
+        }
+
+        //Approximate number of values waiting. Exact only when no thread is active.
+        size_type size() const
+        {
+            const size_type tail = m_enqueue.load(std::memory_order_acquire);
+            const size_type head = m_dequeue.load(std::memory_order_acquire);
+
+            return (tail > head) ? tail - head : 0u;
+        }
+
+        [[nodiscard("This function does not empty the queue.")]] bool empty() const { return size() == 0u; }
+
+        size_type capacity() const { return m_mask + 1u; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+    };
+
+} // namespace aggro
+
+
+#endif // AGGRO_QUEUE_HPP
@@ -0,0 +1,195 @@
+#ifndef AGGRO_SLOT_MAP_HPP
+#define AGGRO_SLOT_MAP_HPP
+
+#include <cstdint>
+#include "array.hpp"
+
+namespace aggro
+{
+    //Names an element of a slot_map. Stays valid until that element is erased, no matter what
+    //else is inserted or erased in the meantime.
+    struct slot_handle
+    {
+        std::uint32_t index = UINT32_MAX;
+        std::uint32_t generation = 0u;
+    };
+
+    inline constexpr bool operator==(const slot_handle& lhs, const slot_handle& rhs)
+    {
+        return lhs.index == rhs.index && lhs.generation == rhs.generation;
+    }
+
+    inline constexpr bool operator!=(const slot_handle& lhs, const slot_handle& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    /*
+        Stores objects densely in a darray and hands out generational handles to them. Insert and erase are
+        O(1): erase moves the last element into the hole instead of shifting everything after it. A handle to
+        an erased element is detected by its generation, and looking it up returns an empty optional_ref.
+        Iteration walks the live elements contiguously, in no particular order.
+    */
+    template<typename T, standard_allocator Alloc = std_contiguous_allocator<T>>
+    class slot_map
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using handle = slot_handle;
+
+        using iterator = T*;
+        using const_iterator = const T*;
+
+    private:
+        static constexpr std::uint32_t end_of_free_list = UINT32_MAX;
+
+        struct slot
+        {
+            std::uint32_t index;      //Dense index of the element, or the next free slot while unused.
+            std::uint32_t generation; //Bumped every time the slot's element is erased.
+        };
+
+        darray<T, Alloc> m_values;
+        darray<std::uint32_t> m_owners;  //Slot that owns each dense element.
+        darray<slot> m_slots;
+        std::uint32_t m_free = end_of_free_list;
+
+        //Dense index of the element named by 'h', or size() if the handle is stale.
+        constexpr size_type index_of(handle h) const
+        {
+            if (h.index >= m_slots.size()) return m_values.size();
+
+            const slot& s = m_slots[h.index];
+
+            if (s.generation != h.generation) return m_values.size();
+
+            return s.index;
+        }
+
+    public:
+        constexpr slot_map()
+        {
+            m_values.expand_factor = 2.0f;
+            m_owners.expand_factor = 2.0f;
+            m_slots.expand_factor = 2.0f;
+        }
+
+        //Constructs a new element and returns its handle.
+        template<typename... Args>
+        constexpr handle emplace(Args&&... args)
+        {
+            std::uint32_t slot_index;
+
+            if (m_free != end_of_free_list)
+            {
+                slot_index = m_free;
+                m_free = m_slots[slot_index].index;
+            }
+            else
+            {
+                slot_index = static_cast<std::uint32_t>(m_slots.size());
+                m_slots.push_back(slot{ 0u, 0u });
+            }
+
+            slot& s = m_slots[slot_index];
+            s.index = static_cast<std::uint32_t>(m_values.size());
+
+            m_values.emplace_back(aggro::forward<Args>(args)...);
+            m_owners.push_back(slot_index);
+
+            return handle{ slot_index, s.generation };
+        }
+
+        constexpr handle insert(const T& value) { return emplace(value); }
+        constexpr handle insert(T&& value) { return emplace(move(value)); }
+
+        //Returns an optional reference to the element, or an empty one if the handle is stale.
+        constexpr aggro::optional_ref<T> find(handle h)
+        {
+            const size_type index = index_of(h);
+
+            if (index != m_values.size())
+                return m_values[index];
+            else
+                return aggro::nullopt_ref_t<T>();
+        }
+
+        constexpr bool contains(handle h) const { return index_of(h) != m_values.size(); }
+
+        //Erases the element named by 'h'. The last element takes its place. Returns false if the handle is stale.
+        constexpr bool erase(handle h)
+        {
+            const size_type index = index_of(h);
+
+            if (index == m_values.size()) return false;
+
+            const size_type last = m_values.size() - 1u;
+
+            if (index != last)
+            {
+                m_values[index] = move(m_values[last]);
+                m_owners[index] = m_owners[last];
+                m_slots[m_owners[index]].index = static_cast<std::uint32_t>(index);
+            }
+
+            m_values.pop_back();
+            m_owners.pop_back();
+
+            slot& s = m_slots[h.index];
+            ++s.generation;
+            s.index = m_free;
+            m_free = h.index;
+
+            return true;
+        }
+
+        //Reserves room for 'cap' elements.
+        constexpr void reserve(size_type cap)
+        {
+            if (cap <= m_values.capacity()) return;
+
+            m_values.reserve(cap);
+            m_owners.reserve(cap);
+            m_slots.reserve(cap);
+        }
+
+        //Erases every element. Every outstanding handle becomes stale.
+        constexpr void clear()
+        {
+            for (size_type i = 0; i < m_owners.size(); i++)
+            {
+                slot& s = m_slots[m_owners[i]];
+                ++s.generation;
+                s.index = m_free;
+                m_free = m_owners[i];
+            }
+
+            m_values.clear();
+            m_owners.clear();
+        }
+
+        //Handle of the element at dense position 'index', e.g. while iterating.
+        constexpr handle handle_at(size_type index) const
+        {
+            const std::uint32_t slot_index = m_owners[index];
+            return handle{ slot_index, m_slots[slot_index].generation };
+        }
+
+        constexpr size_type size() const { return m_values.size(); }
+
+        [[nodiscard("This function does not empty the map.")]] constexpr bool empty() const { return m_values.empty(); }
+
+        constexpr T* data() { return m_values.data(); }
+        constexpr const T* data() const { return m_values.data(); }
+
+        constexpr iterator begin() { return m_values.begin(); }
+        constexpr iterator end() { return m_values.end(); }
+
+        constexpr const_iterator begin() const { return m_values.begin(); }
+        constexpr const_iterator end() const { return m_values.end(); }
+    };
+
+} // namespace aggro
+
+#endif // AGGRO_SLOT_MAP_HPP
@@ -0,0 +1,404 @@
+#ifndef AGGRO_SOA_HPP
+#define AGGRO_SOA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "array.hpp"
+
+namespace aggro
+{
+    //Random access iterator over the rows of a soa_darray. Dereferencing yields a tuple of references,
+    //so rows can be unpacked with structured bindings.
+    template<typename Container>
+    struct soa_iterator
+    {
+        using size_type = std::size_t;
+
+        Container* owner = nullptr;
+        size_type index = 0u;
+
+        constexpr auto operator*() const { return (*owner)[index]; }
+
+        constexpr soa_iterator operator+(size_type ind) const { return soa_iterator{ owner, index + ind }; }
+        constexpr soa_iterator operator-(size_type ind) const { return soa_iterator{ owner, index - ind }; }
+
+        constexpr soa_iterator& operator+=(size_type ind)
+        {
+            index += ind;
+            return *this;
+        }
+
+        constexpr soa_iterator& operator-=(size_type ind)
+        {
+            index -= ind;
+            return *this;
+        }
+
+        constexpr soa_iterator& operator++() //prefix
+        {
+            ++index;
+            return *this;
+        }
+
+        constexpr soa_iterator operator++(int) //postfix
+        {
+            soa_iterator temp = *this;
+            ++index;
+            return temp;
+        }
+
+        constexpr soa_iterator& operator--() //prefix
+        {
+            --index;
+            return *this;
+        }
+
+        constexpr soa_iterator operator--(int) //postfix
+        {
+            soa_iterator temp = *this;
+            --index;
+            return temp;
+        }
+    };
+
+    template<typename Container>
+    inline constexpr bool operator==(const soa_iterator<Container>& lhs, const soa_iterator<Container>& rhs)
+    {
+        return lhs.owner == rhs.owner && lhs.index == rhs.index;
+    }
+
+    template<typename Container>
+    inline constexpr bool operator!=(const soa_iterator<Container>& lhs, const soa_iterator<Container>& rhs)
+    {
+        return lhs.owner != rhs.owner || lhs.index != rhs.index;
+    }
+
+    /*
+        A dynamic array that stores each field of its rows in a column of its own, so a loop over one field only
+        pulls that field through the cache. All columns share one allocation from a byte allocator and grow
+        together with the same expand_factor policy as darray. column<I>() exposes a column as a span for tight
+        loops, while operator[] and the iterators give row-wise access through tuples of references.
+    */
+    template<standard_allocator Alloc, typename... Ts>
+    class basic_soa_darray
+    {
+        static_assert(sizeof...(Ts) > 0u, "A soa_darray needs at least one column.");
+        static_assert(sizeof(std::remove_pointer_t<typename Alloc::memory_resource>) == 1u, "A soa_darray allocates its columns as raw bytes.");
+        static_assert(((alignof(Ts) <= alignof(std::max_align_t)) && ...), "Over-aligned columns are not supported.");
+
+    public:
+        using size_type = std::size_t;
+        using allocator_type = Alloc;
+
+        using reference = std::tuple<Ts&...>;
+        using const_reference = std::tuple<const Ts&...>;
+
+        using iterator = soa_iterator<basic_soa_darray>;
+        using const_iterator = soa_iterator<const basic_soa_darray>;
+
+        static constexpr size_type column_count = sizeof...(Ts);
+
+        template<size_type I>
+        using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+        float expand_factor = 1.0f;
+
+    private:
+        using byte_pointer = typename Alloc::memory_resource;
+
+        allocator_type alloc;
+        size_type m_count = 0u;
+        size_type m_capacity = 0u;
+        size_type m_bytes = 0u;                  //Size of the allocation holding every column.
+        size_type m_offsets[column_count] = {};  //Where each column starts in the allocation, padding included.
+
+        //Byte allocators only promise byte alignment, so every allocation has room to align its start to this.
+        static constexpr size_type base_align = std::max({ alignof(Ts)... });
+
+        static constexpr size_type align_up(size_type n, size_type align)
+        {
+            return (n + align - 1u) & ~(align - 1u);
+        }
+
+        //Bytes needed for 'cap' rows. Fills 'offsets' with the start of each column.
+        static constexpr size_type layout(size_type cap, size_type* offsets)
+        {
+            size_type bytes = 0u;
+            size_type i = 0u;
+
+            ((bytes = align_up(bytes, alignof(Ts)), offsets[i++] = bytes, bytes += sizeof(Ts) * cap), ...);
+
+            return bytes;
+        }
+
+        template<size_type I>
+        constexpr column_type<I>* col() const
+        {
+            return reinterpret_cast<column_type<I>*>(alloc.resource() + m_offsets[I]);
+        }
+
+        //Moves 'num' objects to uninitialized memory at 'dest' and destroys the originals.
+        template<typename T>
+        static constexpr void relocate(T* dest, T* src, size_type num)
+        {
+            if constexpr (trivially_relocatable<T>)
+            {
+                if (num > 0u) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), num * sizeof(T));
+            }
+            else
+            {
+                for (size_type i = 0; i < num; i++)
+                {
+                    new(dest + i) T(move(src[i]));
+                    src[i].~T();
+                }
+            }
+        }
+
+        template<size_type... I>
+        constexpr void relocate_columns(byte_pointer buffer, const size_type* offsets, std::index_sequence<I...>)
+        {
+            (relocate(reinterpret_cast<column_type<I>*>(buffer + offsets[I]), col<I>(), m_count), ...);
+        }
+
+        /*
+            Moves every column into a new allocation with room for 'cap' rows. The allocation is padded so the
+            columns can start at an address aligned for every column type. The padding is folded into the
+            offsets, so the allocator keeps the pointer it handed out.
+        */
+        constexpr void reallocate(size_type cap)
+        {
+            size_type offsets[column_count];
+            const size_type bytes = layout(cap, offsets) + base_align - 1u;
+            byte_pointer buffer = alloc.allocate(bytes);
+
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer);
+            const size_type padding = static_cast<size_type>(align_up(address, base_align) - address);
+
+            for (size_type& offset : offsets)
+                offset += padding;
+
+            if (alloc.resource() != nullptr)
+            {
+                relocate_columns(buffer, offsets, std::index_sequence_for<Ts...>{});
+                alloc.deallocate(alloc.resource(), m_bytes);
+            }
+
+            alloc.set_res(buffer);
+            std::memcpy(m_offsets, offsets, sizeof(offsets));
+            m_capacity = cap;
+            m_bytes = bytes;
+        }
+
+        template<size_type... I, typename... Us>
+        constexpr void construct_row(size_type row, std::index_sequence<I...>, Us&&... values)
+        {
+            (new(col<I>() + row) column_type<I>(aggro::forward<Us>(values)), ...);
+        }
+
+        template<size_type... I>
+        constexpr void destroy_row(size_type row, std::index_sequence<I...>)
+        {
+            (col<I>()[row].~column_type<I>(), ...);
+        }
+
+        template<size_type... I>
+        constexpr void move_row(size_type dest, size_type src, std::index_sequence<I...>)
+        {
+            ((col<I>()[dest] = move(col<I>()[src])), ...);
+        }
+
+        template<size_type... I>
+        constexpr reference row(size_type index, std::index_sequence<I...>) const
+        {
+            return reference(col<I>()[index]...);
+        }
+
+        template<size_type... I>
+        constexpr void copy_rows(const basic_soa_darray& other, std::index_sequence<I...> seq)
+        {
+            for (size_type i = 0; i < other.m_count; i++)
+                construct_row(i, seq, other.template col<I>()[i]...);
+
+            m_count = other.m_count;
+        }
+
+        //Destroys every row and returns the allocation.
+        constexpr void release()
+        {
+            clear();
+
+            if (alloc.resource() != nullptr)
+                alloc.deallocate(alloc.resource(), m_bytes);
+
+            alloc.set_res(nullptr);
+            m_capacity = 0u;
+            m_bytes = 0u;
+        }
+
+        //Takes over the allocation of another soa_darray, leaving it empty.
+        constexpr void take_buffer(basic_soa_darray& other)
+        {
+            alloc.set_res(other.alloc.resource());
+            m_count = other.m_count;
+            m_capacity = other.m_capacity;
+            m_bytes = other.m_bytes;
+            std::memcpy(m_offsets, other.m_offsets, sizeof(m_offsets));
+            expand_factor = other.expand_factor;
+
+            other.alloc.set_res(nullptr);
+            other.m_count = 0u;
+            other.m_capacity = 0u;
+            other.m_bytes = 0u;
+        }
+
+    public:
+        constexpr basic_soa_darray() = default;
+
+        //Allocates room for 'cap' rows. Does not construct any objects.
+        constexpr basic_soa_darray(size_type cap)
+        {
+            reserve(cap);
+        }
+
+        constexpr basic_soa_darray(const basic_soa_darray& other)
+            : expand_factor(other.expand_factor)
+        {
+            reserve(other.m_count);
+            copy_rows(other, std::index_sequence_for<Ts...>{});
+        }
+
+        constexpr basic_soa_darray(basic_soa_darray&& other) noexcept
+        {
+            take_buffer(other);
+        }
+
+        constexpr ~basic_soa_darray() { release(); }
+
+        constexpr basic_soa_darray& operator=(const basic_soa_darray& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.m_count);
+                copy_rows(other, std::index_sequence_for<Ts...>{});
+                expand_factor = other.expand_factor;
+            }
+
+            return *this;
+        }
+
+        constexpr basic_soa_darray& operator=(basic_soa_darray&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                take_buffer(other);
+            }
+
+            return *this;
+        }
+
+        //Returns the row at 'index' as a tuple of references.
+        constexpr reference operator[](size_type index) { return row(index, std::index_sequence_for<Ts...>{}); }
+
+        //Returns the row at 'index' as a tuple of const references.
+        constexpr const_reference operator[](size_type index) const { return row(index, std::index_sequence_for<Ts...>{}); }
+
+        //Returns field I of the row at 'index'.
+        template<size_type I>
+        constexpr column_type<I>& get(size_type index) { return col<I>()[index]; }
+
+        template<size_type I>
+        constexpr const column_type<I>& get(size_type index) const { return col<I>()[index]; }
+
+        //Returns column I as a contiguous span over every row.
+        template<size_type I>
+        constexpr std::span<column_type<I>> column() { return std::span<column_type<I>>(col<I>(), m_count); }
+
+        template<size_type I>
+        constexpr std::span<const column_type<I>> column() const { return std::span<const column_type<I>>(col<I>(), m_count); }
+
+        //Constructs a new row at the end, one argument per column.
+        template<typename... Us> requires (sizeof...(Us) == column_count)
+        constexpr reference emplace_back(Us&&... values)
+        {
+            if (m_count >= m_capacity)
+                reallocate(grown_capacity(m_capacity, expand_factor));
+
+            construct_row(m_count, std::index_sequence_for<Ts...>{}, aggro::forward<Us>(values)...);
+            ++m_count;
+
+            return (*this)[m_count - 1u];
+        }
+
+        constexpr reference push_back(const Ts&... values) { return emplace_back(values...); }
+
+        //Destroys the last row.
+        constexpr void pop_back()
+        {
+            if (m_count == 0u) return;
+
+            --m_count;
+            destroy_row(m_count, std::index_sequence_for<Ts...>{});
+        }
+
+        //Removes the row at 'index', shifting the rows after it down by one.
+        constexpr void erase(size_type index)
+        {
+            if (index >= m_count) return;
+
+            for (size_type i = index + 1u; i < m_count; i++)
+                move_row(i - 1u, i, std::index_sequence_for<Ts...>{});
+
+            pop_back();
+        }
+
+        //Grows the allocation to hold at least 'cap' rows.
+        constexpr void reserve(size_type cap)
+        {
+            if (cap > m_capacity) reallocate(cap);
+        }
+
+        //Destroys every row. The allocation is kept.
+        constexpr void clear()
+        {
+            for (size_type i = 0; i < m_count; i++)
+                destroy_row(i, std::index_sequence_for<Ts...>{});
+
+            m_count = 0u;
+        }
+
+        constexpr size_type size() const { return m_count; }
+        constexpr size_type capacity() const { return m_capacity; }
+
+        //Bytes held by the allocation, including padding between columns.
+        constexpr size_type bytes() const { return m_bytes; }
+
+        [[nodiscard("This function does not empty the array.")]] constexpr bool empty() const { return m_count == 0u; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+
+        constexpr iterator begin() { return iterator{ this, 0u }; }
+        constexpr iterator end() { return iterator{ this, m_count }; }
+
+        constexpr const_iterator begin() const { return const_iterator{ this, 0u }; }
+        constexpr const_iterator end() const { return const_iterator{ this, m_count }; }
+    };
+
+    template<typename... Ts>
+    using soa_darray = basic_soa_darray<std_contiguous_allocator<unsigned char>, Ts...>;
+
+} // namespace aggro
+
+#endif // AGGRO_SOA_HPP
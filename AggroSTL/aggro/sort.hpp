@@ -0,0 +1,751 @@
+#ifndef AGGRO_SORT_HPP
+#define AGGRO_SORT_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "utility.hpp"
+#include "concepts/objects.hpp"
+#include "allocators/standard.hpp"
+
+namespace aggro
+{
+    //Random access iterators the sorts accept: pointers into array and darray, and deque iterators.
+    template<typename It>
+    concept sort_iterator = requires (It it, std::size_t i)
+    {
+        { *(it + i) };
+        { it - it } -> convertible<std::ptrdiff_t>;
+    };
+
+    //Containers whose begin() and end() are sort_iterators.
+    template<typename T>
+    concept sortable_container = requires (T& type)
+    {
+        { type.begin() } -> sort_iterator;
+        { type.end() } -> sort_iterator;
+    };
+
+    //Key types radix_sort can order directly.
+    template<typename T>
+    concept radix_key = (std::is_integral_v<T> && !same<T, bool>) || same<T, float> || same<T, double>;
+
+    /*
+        Scratch memory for radix_sort, kept between calls so sorting every frame stops allocating once the
+        buffer is large enough. The buffer only ever grows, through Alloc.
+    */
+    template<typename T, standard_allocator Alloc = std_contiguous_allocator<T>>
+    class sort_buffer
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using allocator_type = Alloc;
+
+    private:
+        allocator_type alloc;
+        size_type m_capacity = 0u;
+
+    public:
+        constexpr sort_buffer() = default;
+        constexpr ~sort_buffer() { release(); }
+
+        sort_buffer(const sort_buffer&) = delete;
+        sort_buffer& operator=(const sort_buffer&) = delete;
+
+        //Returns room for at least 'count' elements, or nullptr if the allocator has none to give.
+        constexpr T* reserve(size_type count)
+        {
+            if (count <= m_capacity) return alloc.resource();
+
+            release();
+
+            T* buffer = alloc.allocate(count);
+            if (buffer == nullptr) return nullptr;
+
+            alloc.set_res(buffer);
+            m_capacity = count;
+
+            return buffer;
+        }
+
+        constexpr void release()
+        {
+            if (m_capacity == 0u) return;
+
+            alloc.deallocate(alloc.resource(), m_capacity);
+            alloc.set_res(nullptr);
+            m_capacity = 0u;
+        }
+
+        constexpr size_type capacity() const { return m_capacity; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+    };
+
+    namespace sort_detail
+    {
+        //Ranges shorter than this are insertion sorted.
+        inline constexpr std::size_t insertion_sort_threshold = 24u;
+
+        //Ranges longer than this pick their pivot as the median of three medians of three.
+        inline constexpr std::size_t ninther_threshold = 128u;
+
+        //Most elements partial_insertion_sort may move before it gives up.
+        inline constexpr std::size_t partial_insertion_sort_limit = 8u;
+
+        //Elements whose side of the pivot is worked out at once by the branchless partition.
+        inline constexpr std::size_t block_size = 64u;
+
+        //Ranges shorter than this are not worth a radix sort's histogram.
+        inline constexpr std::size_t radix_threshold = 256u;
+
+        //The element 'i' places after 'first'.
+        template<typename It>
+        constexpr auto& at(It first, std::size_t i) { return *(first + i); }
+
+        template<typename It>
+        constexpr void swap_at(It a, std::size_t i, std::size_t j)
+        {
+            auto temp = move(at(a, i));
+            at(a, i) = move(at(a, j));
+            at(a, j) = move(temp);
+        }
+
+        template<typename It>
+        using element_t = std::remove_cvref_t<decltype(*std::declval<It&>())>;
+
+        //Comparisons cheap and predictable enough to be worth partitioning without branches, as in BlockQuicksort.
+        template<typename T, typename Compare>
+        inline constexpr bool branchless = std::is_arithmetic_v<T> &&
+            (same<Compare, std::less<T>> || same<Compare, std::greater<T>> || same<Compare, std::less<>> || same<Compare, std::greater<>>);
+
+        template<typename It, typename Compare>
+        constexpr void insertion_sort(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            for (std::size_t cur = begin + 1u; cur < end; cur++)
+            {
+                std::size_t sift = cur;
+
+                if (comp(at(a, sift), at(a, sift - 1u)))
+                {
+                    auto temp = move(at(a, sift));
+
+                    do
+                    {
+                        at(a, sift) = move(at(a, sift - 1u));
+                        --sift;
+                    } while (sift != begin && comp(temp, at(a, sift - 1u)));
+
+                    at(a, sift) = move(temp);
+                }
+            }
+        }
+
+        //Insertion sort that relies on the element before 'begin' being no greater than anything after it.
+        template<typename It, typename Compare>
+        constexpr void unguarded_insertion_sort(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            for (std::size_t cur = begin + 1u; cur < end; cur++)
+            {
+                std::size_t sift = cur;
+
+                if (comp(at(a, sift), at(a, sift - 1u)))
+                {
+                    auto temp = move(at(a, sift));
+
+                    do
+                    {
+                        at(a, sift) = move(at(a, sift - 1u));
+                        --sift;
+                    } while (comp(temp, at(a, sift - 1u)));
+
+                    at(a, sift) = move(temp);
+                }
+            }
+        }
+
+        //Insertion sort that gives up, returning false, once it has moved too many elements.
+        template<typename It, typename Compare>
+        constexpr bool partial_insertion_sort(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            if (begin == end) return true;
+
+            std::size_t moved = 0u;
+
+            for (std::size_t cur = begin + 1u; cur < end; cur++)
+            {
+                std::size_t sift = cur;
+
+                if (comp(at(a, sift), at(a, sift - 1u)))
+                {
+                    auto temp = move(at(a, sift));
+
+                    do
+                    {
+                        at(a, sift) = move(at(a, sift - 1u));
+                        --sift;
+                    } while (sift != begin && comp(temp, at(a, sift - 1u)));
+
+                    at(a, sift) = move(temp);
+                    moved += cur - sift;
+                }
+
+                if (moved > partial_insertion_sort_limit) return false;
+            }
+
+            return true;
+        }
+
+        template<typename It, typename Compare>
+        constexpr void sort2(It a, std::size_t i, std::size_t j, Compare& comp)
+        {
+            if (comp(at(a, j), at(a, i))) swap_at(a, i, j);
+        }
+
+        //Sorts the elements at i, j and k.
+        template<typename It, typename Compare>
+        constexpr void sort3(It a, std::size_t i, std::size_t j, std::size_t k, Compare& comp)
+        {
+            sort2(a, i, j, comp);
+            sort2(a, j, k, comp);
+            sort2(a, i, j, comp);
+        }
+
+        template<typename It, typename Compare>
+        constexpr void sift_down(It a, std::size_t begin, std::size_t index, std::size_t count, Compare& comp)
+        {
+            auto value = move(at(a, begin + index));
+
+            while (true)
+            {
+                std::size_t child = index * 2u + 1u;
+                if (child >= count) break;
+
+                if (child + 1u < count && comp(at(a, begin + child), at(a, begin + child + 1u))) child++;
+                if (!comp(value, at(a, begin + child))) break;
+
+                at(a, begin + index) = move(at(a, begin + child));
+                index = child;
+            }
+
+            at(a, begin + index) = move(value);
+        }
+
+        //Fallback once too many partitions have come out lopsided, so the worst case stays O(n log n).
+        template<typename It, typename Compare>
+        constexpr void heap_sort(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            const std::size_t count = end - begin;
+
+            for (std::size_t i = count / 2u; i > 0u; i--)
+                sift_down(a, begin, i - 1u, count, comp);
+
+            for (std::size_t last = count; last > 1u; last--)
+            {
+                swap_at(a, begin, begin + last - 1u);
+                sift_down(a, begin, 0u, last - 1u, comp);
+            }
+        }
+
+        struct partition_result
+        {
+            std::size_t pivot = 0u;
+            bool already_partitioned = false;
+        };
+
+        /*
+            Partitions [begin, end) around the pivot at 'begin', putting elements equal to it on the right.
+            Reports whether no element had to move, which hints that the range may already be sorted.
+        */
+        template<typename It, typename Compare>
+        constexpr partition_result partition_right(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            auto pivot = move(at(a, begin));
+            std::size_t first = begin;
+            std::size_t last = end;
+
+            //The median of three guarantees an element not less than the pivot before 'end'.
+            while (comp(at(a, ++first), pivot));
+
+            if (first - 1u == begin)
+                while (first < last && !comp(at(a, --last), pivot));
+            else
+                while (!comp(at(a, --last), pivot));
+
+            const bool already_partitioned = first >= last;
+
+            while (first < last)
+            {
+                swap_at(a, first, last);
+                while (comp(at(a, ++first), pivot));
+                while (!comp(at(a, --last), pivot));
+            }
+
+            const std::size_t pivot_pos = first - 1u;
+            at(a, begin) = move(at(a, pivot_pos));
+            at(a, pivot_pos) = move(pivot);
+
+            return partition_result{ pivot_pos, already_partitioned };
+        }
+
+        //Moves the elements at the given offsets from 'first' and back from 'last' across to each other.
+        template<typename It>
+        constexpr void swap_offsets(It a, std::size_t first, std::size_t last, const unsigned char* offsets_l,
+            const unsigned char* offsets_r, std::size_t count, bool use_swaps)
+        {
+            if (use_swaps)
+            {
+                //Both sides have the same number of misplaced elements, so a plain swap per pair is needed
+                //to keep the sides apart.
+                for (std::size_t i = 0; i < count; i++)
+                    swap_at(a, first + offsets_l[i], last - offsets_r[i]);
+            }
+            else if (count > 0u)
+            {
+                //Otherwise one cyclic permutation moves every element once instead of three times.
+                std::size_t l = first + offsets_l[0];
+                std::size_t r = last - offsets_r[0];
+                auto temp = move(at(a, l));
+                at(a, l) = move(at(a, r));
+
+                for (std::size_t i = 1u; i < count; i++)
+                {
+                    l = first + offsets_l[i];
+                    at(a, r) = move(at(a, l));
+                    r = last - offsets_r[i];
+                    at(a, l) = move(at(a, r));
+                }
+
+                at(a, r) = move(temp);
+            }
+        }
+
+        /*
+            partition_right without a branch per comparison. Blocks of elements from both ends are compared
+            first and the offsets of misplaced ones recorded, then the recorded elements are swapped, so the
+            comparisons never feed a mispredicted branch.
+        */
+        template<typename It, typename Compare>
+        constexpr partition_result partition_right_branchless(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            auto pivot = move(at(a, begin));
+            std::size_t first = begin;
+            std::size_t last = end;
+
+            while (comp(at(a, ++first), pivot));
+
+            if (first - 1u == begin)
+                while (first < last && !comp(at(a, --last), pivot));
+            else
+                while (!comp(at(a, --last), pivot));
+
+            const bool already_partitioned = first >= last;
+
+            if (!already_partitioned)
+            {
+                swap_at(a, first, last);
+                ++first;
+
+                alignas(cache_line_size) unsigned char offsets_l[block_size];
+                alignas(cache_line_size) unsigned char offsets_r[block_size];
+
+                std::size_t base_l = first;
+                std::size_t base_r = last;
+                std::size_t num_l = 0u, num_r = 0u, start_l = 0u, start_r = 0u;
+
+                while (first < last)
+                {
+                    //Fill whichever offset buffers are empty, splitting what is left between them.
+                    const std::size_t unknown = last - first;
+                    const std::size_t left_split = (num_l == 0u) ? ((num_r == 0u) ? unknown / 2u : unknown) : 0u;
+                    const std::size_t right_split = (num_r == 0u) ? unknown - left_split : 0u;
+
+                    const std::size_t left_count = (left_split < block_size) ? left_split : block_size;
+                    const std::size_t right_count = (right_split < block_size) ? right_split : block_size;
+
+                    for (std::size_t i = 0; i < left_count; i++)
+                    {
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(at(a, first), pivot);
+                        ++first;
+                    }
+
+                    for (std::size_t i = 0; i < right_count;)
+                    {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += comp(at(a, --last), pivot);
+                    }
+
+                    const std::size_t count = (num_l < num_r) ? num_l : num_r;
+                    swap_offsets(a, base_l, base_r, offsets_l + start_l, offsets_r + start_r, count, num_l == num_r);
+
+                    num_l -= count;
+                    num_r -= count;
+                    start_l += count;
+                    start_r += count;
+
+                    if (num_l == 0u)
+                    {
+                        start_l = 0u;
+                        base_l = first;
+                    }
+
+                    if (num_r == 0u)
+                    {
+                        start_r = 0u;
+                        base_r = last;
+                    }
+                }
+
+                //One side still has misplaced elements. Swap them to the far end of the other side.
+                if (num_l > 0u)
+                {
+                    while (num_l > 0u)
+                        swap_at(a, base_l + offsets_l[start_l + --num_l], --last);
+
+                    first = last;
+                }
+
+                if (num_r > 0u)
+                {
+                    while (num_r > 0u)
+                        swap_at(a, base_r - offsets_r[start_r + --num_r], first++);
+
+                    last = first;
+                }
+            }
+
+            const std::size_t pivot_pos = first - 1u;
+            at(a, begin) = move(at(a, pivot_pos));
+            at(a, pivot_pos) = move(pivot);
+
+            return partition_result{ pivot_pos, already_partitioned };
+        }
+
+        //Partitions around the pivot at 'begin', putting elements equal to it on the left. Used when the pivot
+        //equals the element before the range, so all of them can be skipped at once.
+        template<typename It, typename Compare>
+        constexpr std::size_t partition_left(It a, std::size_t begin, std::size_t end, Compare& comp)
+        {
+            auto pivot = move(at(a, begin));
+            std::size_t first = begin;
+            std::size_t last = end;
+
+            while (comp(pivot, at(a, --last)));
+
+            if (last + 1u == end)
+                while (first < last && !comp(pivot, at(a, ++first)));
+            else
+                while (!comp(pivot, at(a, ++first)));
+
+            while (first < last)
+            {
+                swap_at(a, first, last);
+                while (comp(pivot, at(a, --last)));
+                while (!comp(pivot, at(a, ++first)));
+            }
+
+            at(a, begin) = move(at(a, last));
+            at(a, last) = move(pivot);
+
+            return last;
+        }
+
+        template<bool Branchless, typename It, typename Compare>
+        constexpr void pdqsort_loop(It a, std::size_t begin, std::size_t end, Compare& comp, int bad_allowed, bool leftmost)
+        {
+            while (true)
+            {
+                const std::size_t size = end - begin;
+
+                if (size < insertion_sort_threshold)
+                {
+                    if (leftmost) insertion_sort(a, begin, end, comp);
+                    else unguarded_insertion_sort(a, begin, end, comp);
+
+                    return;
+                }
+
+                //Move the chosen pivot to 'begin'.
+                const std::size_t half = size / 2u;
+
+                if (size > ninther_threshold)
+                {
+                    sort3(a, begin, begin + half, end - 1u, comp);
+                    sort3(a, begin + 1u, begin + half - 1u, end - 2u, comp);
+                    sort3(a, begin + 2u, begin + half + 1u, end - 3u, comp);
+                    sort3(a, begin + half - 1u, begin + half, begin + half + 1u, comp);
+                    swap_at(a, begin, begin + half);
+                }
+                else
+                {
+                    sort3(a, begin + half, begin, end - 1u, comp);
+                }
+
+                //If the pivot equals the element before this range, everything equal to it is in place already.
+                if (!leftmost && !comp(at(a, begin - 1u), at(a, begin)))
+                {
+                    begin = partition_left(a, begin, end, comp) + 1u;
+                    continue;
+                }
+
+                const partition_result part = Branchless
+                    ? partition_right_branchless(a, begin, end, comp)
+                    : partition_right(a, begin, end, comp);
+
+                const std::size_t pivot = part.pivot;
+                const std::size_t l_size = pivot - begin;
+                const std::size_t r_size = end - (pivot + 1u);
+
+                if (l_size < size / 8u || r_size < size / 8u)
+                {
+                    if (--bad_allowed == 0)
+                    {
+                        heap_sort(a, begin, end, comp);
+                        return;
+                    }
+
+                    //Break up patterns that fool the pivot choice by swapping a few elements around.
+                    if (l_size >= insertion_sort_threshold)
+                    {
+                        swap_at(a, begin, begin + l_size / 4u);
+                        swap_at(a, pivot - 1u, pivot - l_size / 4u);
+
+                        if (l_size > ninther_threshold)
+                        {
+                            swap_at(a, begin + 1u, begin + (l_size / 4u + 1u));
+                            swap_at(a, begin + 2u, begin + (l_size / 4u + 2u));
+                            swap_at(a, pivot - 2u, pivot - (l_size / 4u + 1u));
+                            swap_at(a, pivot - 3u, pivot - (l_size / 4u + 2u));
+                        }
+                    }
+
+                    if (r_size >= insertion_sort_threshold)
+                    {
+                        swap_at(a, pivot + 1u, pivot + (1u + r_size / 4u));
+                        swap_at(a, end - 1u, end - r_size / 4u);
+
+                        if (r_size > ninther_threshold)
+                        {
+                            swap_at(a, pivot + 2u, pivot + (2u + r_size / 4u));
+                            swap_at(a, pivot + 3u, pivot + (3u + r_size / 4u));
+                            swap_at(a, end - 2u, end - (1u + r_size / 4u));
+                            swap_at(a, end - 3u, end - (2u + r_size / 4u));
+                        }
+                    }
+                }
+                else if (part.already_partitioned && partial_insertion_sort(a, begin, pivot, comp) &&
+                    partial_insertion_sort(a, pivot + 1u, end, comp))
+                {
+                    //A balanced partition that moved nothing usually means the range was sorted already.
+                    return;
+                }
+
+                //Recurse into the left side and loop on the right one, keeping the stack O(log n).
+                pdqsort_loop<Branchless>(a, begin, pivot, comp, bad_allowed, leftmost);
+                begin = pivot + 1u;
+                leftmost = false;
+            }
+        }
+
+        //Maps a key to an unsigned integer with the same order, so it can be sorted digit by digit.
+        template<radix_key K>
+        constexpr auto radix_bits(K key)
+        {
+            using U = std::conditional_t<sizeof(K) == 8u, std::uint64_t,
+                std::conditional_t<sizeof(K) == 4u, std::uint32_t,
+                std::conditional_t<sizeof(K) == 2u, std::uint16_t, std::uint8_t>>>;
+
+            constexpr U sign = U(1) << (sizeof(K) * 8u - 1u);
+
+            if constexpr (std::is_floating_point_v<K>)
+            {
+                //Negative floats sort backwards as integers, so all their bits are flipped.
+                const U bits = std::bit_cast<U>(key);
+                return static_cast<U>((bits & sign) ? ~bits : (bits | sign));
+            }
+            else if constexpr (std::is_signed_v<K>)
+            {
+                return static_cast<U>(static_cast<U>(key) ^ sign);
+            }
+            else
+            {
+                return static_cast<U>(key);
+            }
+        }
+
+        //Orders elements the way radix_sort does, which is a strict weak order even for NaN keys.
+        template<typename Key>
+        struct key_less
+        {
+            Key& key;
+
+            template<typename T>
+            constexpr bool operator()(const T& a, const T& b) const { return radix_bits(key(a)) < radix_bits(key(b)); }
+        };
+
+        template<typename It, typename Key>
+        using radix_bits_t = decltype(radix_bits(std::declval<Key&>()(*std::declval<It&>())));
+
+        //Moves every element of 'src' to its slot in 'dst' by the digit at 'shift', keeping equal digits in order.
+        template<typename Src, typename Dst, typename Key>
+        constexpr void scatter(Src src, Dst dst, std::size_t count, std::size_t* offsets, unsigned int shift, Key& key)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                auto& value = at(src, i);
+                const std::size_t digit = static_cast<std::size_t>((radix_bits(key(value)) >> shift) & 0xFFu);
+                at(dst, offsets[digit]++) = move(value);
+            }
+        }
+
+        /*
+            LSD radix sort of 'count' elements from 'first' by key(element), one byte per pass. The histograms for
+            every pass are built in a single read, and passes where every key has the same byte are skipped.
+            Elements ping-pong between the range and 'scratch', which must hold 'count' elements.
+        */
+        template<typename It, typename T, typename Key>
+        constexpr void radix_sort(It first, std::size_t count, T* scratch, Key& key)
+        {
+            using bits_type = radix_bits_t<It, Key>;
+            constexpr unsigned int passes = sizeof(bits_type);
+
+            std::size_t counts[passes][256] = {};
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const bits_type bits = radix_bits(key(at(first, i)));
+
+                for (unsigned int p = 0; p < passes; p++)
+                    counts[p][(bits >> (p * 8u)) & 0xFFu]++;
+            }
+
+            const bits_type first_bits = radix_bits(key(at(first, 0u)));
+            bool in_scratch = false;
+
+            for (unsigned int p = 0; p < passes; p++)
+            {
+                std::size_t* offsets = counts[p];
+
+                if (offsets[(first_bits >> (p * 8u)) & 0xFFu] == count) continue;
+
+                std::size_t total = 0u;
+
+                for (std::size_t d = 0; d < 256u; d++)
+                {
+                    const std::size_t digits = offsets[d];
+                    offsets[d] = total;
+                    total += digits;
+                }
+
+                if (in_scratch)
+                    scatter(scratch, first, count, offsets, p * 8u, key);
+                else
+                    scatter(first, scratch, count, offsets, p * 8u, key);
+
+                in_scratch = !in_scratch;
+            }
+
+            if (in_scratch)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    at(first, i) = move(scratch[i]);
+            }
+        }
+
+    } // namespace sort_detail
+
+    /*
+        Sorts [first, last) with pattern-defeating quicksort: introsort that picks its pivot from a median of
+        medians, detects sorted and reverse-sorted runs, groups elements equal to the pivot and falls back to
+        heap sort if partitions keep coming out lopsided. Arithmetic elements compared with std::less or
+        std::greater are partitioned without branches. O(n log n) worst case; not stable.
+    */
+    template<sort_iterator It, typename Compare = std::less<>>
+    constexpr void sort(It first, It last, Compare comp = Compare{})
+    {
+        const std::ptrdiff_t count = last - first;
+        if (count < 2) return;
+
+        constexpr bool branchless = sort_detail::branchless<sort_detail::element_t<It>, Compare>;
+        const int bad_allowed = std::bit_width(static_cast<std::size_t>(count));
+
+        sort_detail::pdqsort_loop<branchless>(first, 0u, static_cast<std::size_t>(count), comp, bad_allowed, true);
+    }
+
+    template<sortable_container Container, typename Compare = std::less<>>
+    constexpr void sort(Container& container, Compare comp = Compare{})
+    {
+        sort(container.begin(), container.end(), comp);
+    }
+
+    /*
+        Sorts [first, last) by key(element), which must be an integer or floating point value, with an LSD radix
+        sort: O(n) per byte of key, stable, and no comparisons. Floats order -0.0 before 0.0 and put NaNs at the
+        ends. Elements must be trivially copyable, since they are moved through the uninitialized 'scratch'.
+        Short ranges, and ranges 'scratch' cannot grow to fit, are sorted by sort() instead.
+    */
+    template<sort_iterator It, typename T, standard_allocator Alloc, typename Key = std::identity>
+        requires radix_key<std::remove_cvref_t<std::invoke_result_t<Key&, const sort_detail::element_t<It>&>>>
+    constexpr void radix_sort(It first, It last, sort_buffer<T, Alloc>& scratch, Key key = Key{})
+    {
+        static_assert(same<T, sort_detail::element_t<It>>, "The scratch buffer must hold the element type.");
+        static_assert(std::is_trivially_copyable_v<T>, "radix_sort moves elements through uninitialized memory.");
+
+        const std::size_t count = static_cast<std::size_t>(last - first);
+        T* buffer = (count >= sort_detail::radix_threshold) ? scratch.reserve(count) : nullptr;
+
+        if (buffer == nullptr)
+        {
+            sort(first, last, sort_detail::key_less<Key>{ key });
+            return;
+        }
+
+        sort_detail::radix_sort(first, count, buffer, key);
+    }
+
+    //Radix sorts a container, reusing 'scratch' for the temporary copy.
+    template<sortable_container Container, typename T, standard_allocator Alloc, typename Key = std::identity>
+    constexpr void radix_sort(Container& container, sort_buffer<T, Alloc>& scratch, Key key = Key{})
+    {
+        radix_sort(container.begin(), container.end(), scratch, key);
+    }
+
+    /*
+        Radix sorts a container, taking the scratch memory from its own allocator for the length of the call.
+        Keep a sort_buffer and use the overload above to sort repeatedly without allocating.
+    */
+    template<sortable_container Container, typename Key = std::identity>
+        requires std::invocable<Key&, const sort_detail::element_t<decltype(std::declval<Container&>().begin())>&> &&
+            requires (Container& c) { { c.get_allocator()->allocate(c.size()) } -> pointer; }
+    constexpr void radix_sort(Container& container, Key key = Key{})
+    {
+        using T = sort_detail::element_t<decltype(container.begin())>;
+
+        static_assert(radix_key<std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>>, "radix_sort needs an integer or floating point key.");
+        static_assert(std::is_trivially_copyable_v<T>, "radix_sort moves elements through uninitialized memory.");
+
+        const std::size_t count = container.size();
+        auto* alloc = container.get_allocator();
+        T* buffer = (count >= sort_detail::radix_threshold) ? alloc->allocate(count) : nullptr;
+
+        if (buffer == nullptr)
+        {
+            sort(container.begin(), container.end(), sort_detail::key_less<Key>{ key });
+            return;
+        }
+
+        sort_detail::radix_sort(container.begin(), count, buffer, key);
+        alloc->deallocate(buffer, count);
+    }
+
+} // namespace aggro
+
+#endif // AGGRO_SORT_HPP
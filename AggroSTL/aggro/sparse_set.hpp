@@ -0,0 +1,188 @@
+#ifndef AGGRO_SPARSE_SET_HPP
+#define AGGRO_SPARSE_SET_HPP
+
+#include <cstdint>
+#include "array.hpp"
+
+namespace aggro
+{
+    /*
+        Maps small integer ids, such as entity ids, to values. A sparse darray indexed by id points into packed
+        dense darrays of ids and values, so contains, insert and erase are O(1) and the values can be walked
+        contiguously. Erasing moves the last value into the hole. sort_as() reorders the packed arrays to
+        follow another set, so a loop over several component sets touches each one front to back.
+    */
+    template<typename T, standard_allocator Alloc = std_contiguous_allocator<T>>
+    class sparse_set
+    {
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using entity_type = std::uint32_t;
+
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        //Marks ids that are not in the set.
+        static constexpr entity_type tombstone = UINT32_MAX;
+
+    private:
+        darray<entity_type> m_sparse;   //Dense index of each id, or tombstone.
+        darray<entity_type> m_entities; //Id of each packed value.
+        darray<T, Alloc> m_values;
+
+        //Swaps two packed entries and fixes their sparse links.
+        constexpr void swap_dense(size_type a, size_type b)
+        {
+            if (a == b) return;
+
+            T temp = move(m_values[a]);
+            m_values[a] = move(m_values[b]);
+            m_values[b] = move(temp);
+
+            const entity_type id = m_entities[a];
+            m_entities[a] = m_entities[b];
+            m_entities[b] = id;
+
+            m_sparse[m_entities[a]] = static_cast<entity_type>(a);
+            m_sparse[m_entities[b]] = static_cast<entity_type>(b);
+        }
+
+    public:
+        constexpr sparse_set()
+        {
+            m_sparse.expand_factor = 2.0f;
+            m_entities.expand_factor = 2.0f;
+            m_values.expand_factor = 2.0f;
+        }
+
+        constexpr bool contains(entity_type id) const
+        {
+            return id < m_sparse.size() && m_sparse[id] != tombstone;
+        }
+
+        //Dense position of 'id', or tombstone if it is not in the set.
+        constexpr entity_type index_of(entity_type id) const
+        {
+            return (id < m_sparse.size()) ? m_sparse[id] : tombstone;
+        }
+
+        //Returns an optional reference to the value stored for 'id'.
+        constexpr aggro::optional_ref<T> find(entity_type id)
+        {
+            if (contains(id))
+                return m_values[m_sparse[id]];
+            else
+                return aggro::nullopt_ref_t<T>();
+        }
+
+        //Constructs a value for 'id' if it has none yet. Returns the stored value either way.
+        template<typename... Args>
+        constexpr T& emplace(entity_type id, Args&&... args)
+        {
+            if (contains(id)) return m_values[m_sparse[id]];
+
+            if (id >= m_sparse.size())
+            {
+                if (id >= m_sparse.capacity())
+                {
+                    const size_type doubled = m_sparse.capacity() * 2u;
+                    m_sparse.reserve(doubled > id ? doubled : id + 1u);
+                }
+
+                while (m_sparse.size() <= id)
+                    m_sparse.push_back(tombstone);
+            }
+
+            m_sparse[id] = static_cast<entity_type>(m_values.size());
+            m_entities.push_back(id);
+
+            return m_values.emplace_back(aggro::forward<Args>(args)...);
+        }
+
+        //Inserts a value for 'id'. Returns false if it already had one.
+        constexpr bool insert(entity_type id, const T& value)
+        {
+            if (contains(id)) return false;
+
+            emplace(id, value);
+            return true;
+        }
+
+        //Removes the value of 'id'. The last value takes its place. Returns false if there was none.
+        constexpr bool erase(entity_type id)
+        {
+            if (!contains(id)) return false;
+
+            const size_type last = m_values.size() - 1u;
+
+            swap_dense(m_sparse[id], last);
+
+            m_values.pop_back();
+            m_entities.pop_back();
+            m_sparse[id] = tombstone;
+
+            return true;
+        }
+
+        /*
+            Reorders the packed arrays so the ids shared with 'other' come first, in the order 'other' stores
+            them. Ids only this set has end up after them. Afterwards the first shared entries of both sets line
+            up index for index.
+        */
+        template<typename U, standard_allocator A>
+        constexpr void sort_as(const sparse_set<U, A>& other)
+        {
+            size_type pos = 0u;
+
+            for (entity_type id : other.entities())
+            {
+                if (contains(id))
+                {
+                    swap_dense(m_sparse[id], pos);
+                    ++pos;
+                }
+            }
+        }
+
+        //Reserves room for 'cap' values and ids below 'cap'.
+        constexpr void reserve(size_type cap)
+        {
+            if (cap > m_values.capacity())
+            {
+                m_entities.reserve(cap);
+                m_values.reserve(cap);
+            }
+
+            if (cap > m_sparse.capacity()) m_sparse.reserve(cap);
+        }
+
+        constexpr void clear()
+        {
+            for (entity_type id : m_entities)
+                m_sparse[id] = tombstone;
+
+            m_entities.clear();
+            m_values.clear();
+        }
+
+        //The ids in the order their values are packed.
+        constexpr const darray<entity_type>& entities() const { return m_entities; }
+
+        constexpr size_type size() const { return m_values.size(); }
+
+        [[nodiscard("This function does not empty the set.")]] constexpr bool empty() const { return m_values.empty(); }
+
+        constexpr T* data() { return m_values.data(); }
+        constexpr const T* data() const { return m_values.data(); }
+
+        constexpr iterator begin() { return m_values.begin(); }
+        constexpr iterator end() { return m_values.end(); }
+
+        constexpr const_iterator begin() const { return m_values.begin(); }
+        constexpr const_iterator end() const { return m_values.end(); }
+    };
+
+} // namespace aggro
+
+#endif // AGGRO_SPARSE_SET_HPP
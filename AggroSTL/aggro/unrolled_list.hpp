@@ -0,0 +1,604 @@
+#ifndef AGGRO_UNROLLED_LIST_HPP
+#define AGGRO_UNROLLED_LIST_HPP
+
+#include <cstring>
+#include <new>
+#include <initializer_list>
+#include "utility.hpp"
+#include "concepts/stream.hpp"
+#include "allocators/standard.hpp"
+
+namespace aggro
+{
+    /*
+        Block struct for an unrolled_list. Holds up to 'Size' elements packed at the front of its storage.
+    */
+    template<typename T, std::size_t Size>
+    struct unode
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+
+        unode* prev = nullptr;
+        unode* next = nullptr;
+        size_type count = 0u;
+        alignas(T) unsigned char storage[sizeof(T) * Size];
+
+        constexpr unode() = default;
+        constexpr ~unode() = default;
+
+        constexpr T* data() { return reinterpret_cast<T*>(storage); }
+        constexpr const T* data() const { return reinterpret_cast<const T*>(storage); }
+    };
+
+    //This iterator meets the 'LegacyBidirectionalIterator' standard for lists.
+    //The end iterator points one past the last element of the last block, so --end() works.
+    template<typename T, std::size_t Size>
+    struct u_iterator
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using u_node = unode<T, Size>;
+
+        u_node* node = nullptr;
+        size_type index = 0u;
+
+        //Get the underlying block.
+        constexpr u_node* get() const { return node; }
+
+        constexpr T& operator*()
+        {
+            return node->data()[index];
+        }
+
+        constexpr const T& operator*() const
+        {
+            return node->data()[index];
+        }
+
+        constexpr u_iterator operator+(size_type ind) const
+        {
+            u_iterator it = *this;
+            it += ind;
+            return it;
+        }
+
+        constexpr u_iterator operator-(size_type ind) const
+        {
+            u_iterator it = *this;
+            it -= ind;
+            return it;
+        }
+
+        //Skips whole blocks at a time where it can.
+        constexpr u_iterator& operator+=(size_type ind)
+        {
+            while (ind != 0u)
+            {
+                const size_type left = node->count - index;
+
+                if (ind < left || node->next == nullptr)
+                {
+                    index += ind;
+                    break;
+                }
+
+                ind -= left;
+                node = node->next;
+                index = 0u;
+            }
+
+            return *this;
+        }
+
+        constexpr u_iterator& operator-=(size_type ind)
+        {
+            while (ind > index)
+            {
+                ind -= index + 1u;
+                node = node->prev;
+                index = node->count - 1u;
+            }
+
+            index -= ind;
+            return *this;
+        }
+
+        constexpr u_iterator& operator++() //prefix
+        {
+            if (++index == node->count && node->next)
+            {
+                node = node->next;
+                index = 0u;
+            }
+
+            return *this;
+        }
+
+        constexpr u_iterator operator++(int) //postfix
+        {
+            u_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        constexpr u_iterator& operator--() //prefix
+        {
+            if (index == 0u)
+            {
+                node = node->prev;
+                index = node->count;
+            }
+
+            --index;
+            return *this;
+        }
+
+        constexpr u_iterator operator--(int) //postfix
+        {
+            u_iterator old = *this;
+            --(*this);
+            return old;
+        }
+    };
+
+    template<typename T, std::size_t Size>
+    inline constexpr bool operator==(const u_iterator<T, Size>& lhs, const u_iterator<T, Size>& rhs)
+    {
+        return lhs.node == rhs.node && lhs.index == rhs.index;
+    }
+
+    template<typename T, std::size_t Size>
+    inline constexpr bool operator!=(const u_iterator<T, Size>& lhs, const u_iterator<T, Size>& rhs)
+    {
+        return lhs.node != rhs.node || lhs.index != rhs.index;
+    }
+
+    /*
+        A doubley-linked list of blocks that each hold up to 'Size' elements. Inserting in the middle only shifts
+        the elements of one block, and a full block is split in half instead of growing. A block that drops
+        below half full after an erase is merged with a neighbour when they fit together, so blocks stay dense
+        and a walk over the list touches about 1/Size as many nodes as a dlist. Blocks are allocated through
+        Alloc, which takes a unode<T, Size> as its template parameter. Inserting or erasing invalidates
+        iterators into the blocks it touches.
+    */
+    template<typename T, std::size_t Size, standard_allocator Alloc = std_node_allocator<unode<T, Size>>>
+    class unrolled_list
+    {
+        static_assert(Size > 0u, "An unrolled_list block must hold at least one element.");
+
+        using u_node = unode<T, Size>;
+
+    public:
+
+        using size_type = std::size_t;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+
+        using iterator = u_iterator<T, Size>;
+        using const_iterator = const u_iterator<T, Size>;
+        using allocator_type = Alloc;
+
+        static constexpr size_type block_size = Size;
+
+    private:
+
+        //Blocks with fewer elements than this try to merge with a neighbour.
+        static constexpr size_type min_fill = Size / 2u;
+
+        allocator_type alloc;
+        size_type m_count = 0u;
+        size_type m_blocks = 0u;
+
+        //Moves 'num' objects to 'dest' and destroys the originals. The ranges may overlap.
+        static constexpr void relocate(T* dest, T* src, size_type num)
+        {
+            if (num == 0u || dest == src) return;
+
+            if constexpr (trivially_relocatable<T>)
+            {
+                std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), num * sizeof(T));
+            }
+            else if (dest < src)
+            {
+                for (size_type i = 0; i < num; i++)
+                {
+                    new(dest + i) T(move(src[i]));
+                    src[i].~T();
+                }
+            }
+            else
+            {
+                for (size_type i = num; i > 0u; i--)
+                {
+                    new(dest + i - 1u) T(move(src[i - 1u]));
+                    src[i - 1u].~T();
+                }
+            }
+        }
+
+        //Allocates an empty block and links it in between 'before' and 'after'.
+        constexpr u_node* link_block(u_node* before, u_node* after)
+        {
+            u_node* block = alloc.allocate(1);
+            new(block) u_node();
+
+            block->prev = before;
+            block->next = after;
+
+            if (before)
+                before->next = block;
+            else
+                alloc.set_head(block);
+
+            if (after)
+                after->prev = block;
+            else
+                alloc.set_tail(block);
+
+            ++m_blocks;
+            return block;
+        }
+
+        //Unlinks and frees a block. Its elements must already be destroyed or moved out.
+        constexpr void unlink_block(u_node* block)
+        {
+            if (block->prev)
+                block->prev->next = block->next;
+            else
+                alloc.set_head(block->next);
+
+            if (block->next)
+                block->next->prev = block->prev;
+            else
+                alloc.set_tail(block->prev);
+
+            block->~u_node();
+            alloc.deallocate(block, 1);
+            --m_blocks;
+        }
+
+        //Moves the upper half of a full block into a new block after it.
+        constexpr u_node* split(u_node* block)
+        {
+            u_node* right = link_block(block, block->next);
+            const size_type half = block->count / 2u;
+
+            relocate(right->data(), block->data() + half, block->count - half);
+            right->count = block->count - half;
+            block->count = half;
+
+            return right;
+        }
+
+        //The position (block, index) as an iterator, stepping onto the next block if it is past this one's end.
+        constexpr iterator normalize(u_node* block, size_type index)
+        {
+            if (index == block->count && block->next)
+                return iterator{ block->next, 0u };
+
+            return iterator{ block, index };
+        }
+
+        template<typename... Args>
+        constexpr iterator _emplace(u_node* block, size_type index, Args&&... args)
+        {
+            if (block == nullptr)
+            {
+                block = link_block(nullptr, nullptr);
+                index = 0u;
+            }
+            else if (block->count == Size)
+            {
+                if (index == Size)
+                {
+                    //Appending past a full tail.
+                    block = link_block(block, block->next);
+                    index = 0u;
+                }
+                else if (index == 0u)
+                {
+                    //Prepending to a full block. Use the end of the previous block if it has room.
+                    if (block->prev && block->prev->count < Size)
+                    {
+                        block = block->prev;
+                        index = block->count;
+                    }
+                    else
+                    {
+                        block = link_block(block->prev, block);
+                    }
+                }
+                else
+                {
+                    u_node* right = split(block);
+
+                    if (index > block->count)
+                    {
+                        index -= block->count;
+                        block = right;
+                    }
+                }
+            }
+
+            T* spot = block->data() + index;
+
+            relocate(spot + 1, spot, block->count - index);
+            new(spot) T(aggro::forward<Args>(args)...);
+
+            ++block->count;
+            ++m_count;
+
+            return iterator{ block, index };
+        }
+
+        //Folds 'block' into a neighbour if it is under-full and they fit in one block.
+        constexpr iterator merge(u_node* block, size_type index)
+        {
+            u_node* next = block->next;
+            u_node* prev = block->prev;
+
+            if (next && block->count + next->count <= Size)
+            {
+                relocate(block->data() + block->count, next->data(), next->count);
+                block->count += next->count;
+                next->count = 0u;
+                unlink_block(next);
+            }
+            else if (prev && prev->count + block->count <= Size)
+            {
+                relocate(prev->data() + prev->count, block->data(), block->count);
+                index += prev->count;
+                prev->count += block->count;
+                block->count = 0u;
+                unlink_block(block);
+                block = prev;
+            }
+
+            return normalize(block, index);
+        }
+
+        template<typename Other>
+        constexpr void copy_from(const Other& other)
+        {
+            for (const T& value : other)
+                emplace_back(value);
+        }
+
+    public:
+
+        constexpr unrolled_list() = default;
+
+        constexpr unrolled_list(const std::initializer_list<T>& init)
+        {
+            copy_from(init);
+        }
+
+        constexpr unrolled_list(const unrolled_list& other)
+        {
+            copy_from(other);
+        }
+
+        //Takes the blocks along with the allocator that owns them, so a pool or arena set on 'other' carries over.
+        constexpr unrolled_list(unrolled_list&& other) noexcept
+        : alloc(move(other.alloc)), m_count(other.m_count), m_blocks(other.m_blocks)
+        {
+            other.alloc.unlink();
+
+            other.m_count = 0u;
+            other.m_blocks = 0u;
+        }
+
+        constexpr unrolled_list& operator=(const unrolled_list& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_from(other);
+            }
+
+            return *this;
+        }
+
+        constexpr unrolled_list& operator=(unrolled_list&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+
+                alloc = move(other.alloc);
+                other.alloc.unlink();
+
+                m_count = other.m_count;
+                m_blocks = other.m_blocks;
+                other.m_count = 0u;
+                other.m_blocks = 0u;
+            }
+
+            return *this;
+        }
+
+        constexpr ~unrolled_list() { clear(); }
+
+        //Return the first element.
+        constexpr reference front() { return alloc.resource()->data()[0]; }
+
+        //Return the first element.
+        constexpr const_reference front() const { return alloc.resource()->data()[0]; }
+
+        //Return the last element.
+        constexpr reference back() { return alloc.resource_rev()->data()[alloc.resource_rev()->count - 1u]; }
+
+        //Return the last element.
+        constexpr const_reference back() const { return alloc.resource_rev()->data()[alloc.resource_rev()->count - 1u]; }
+
+        //Construct a new element in place at the front.
+        template<typename... Args>
+        constexpr iterator emplace_front(Args&&... args)
+        {
+            return _emplace(alloc.resource(), 0u, aggro::forward<Args>(args)...);
+        }
+
+        //Construct a new element in place at the back.
+        template<typename... Args>
+        constexpr iterator emplace_back(Args&&... args)
+        {
+            u_node* tail = alloc.resource_rev();
+            return _emplace(tail, tail ? tail->count : 0u, aggro::forward<Args>(args)...);
+        }
+
+        constexpr iterator push_front(const T& value) { return emplace_front(value); }
+        constexpr iterator push_front(T&& value) { return emplace_front(move(value)); }
+
+        constexpr iterator push_back(const T& value) { return emplace_back(value); }
+        constexpr iterator push_back(T&& value) { return emplace_back(move(value)); }
+
+        //Construct a new element in place before the specified location.
+        template<typename... Args>
+        constexpr iterator emplace(iterator loc, Args&&... args)
+        {
+            return _emplace(loc.get(), loc.index, aggro::forward<Args>(args)...);
+        }
+
+        //Insert a value before the specified location.
+        constexpr iterator insert(iterator loc, const T& value) { return emplace(loc, value); }
+
+        //Insert a value before the specified location.
+        constexpr iterator insert(iterator loc, T&& value) { return emplace(loc, move(value)); }
+
+        //Remove the element at the specified location. Returns an iterator to the element after it.
+        constexpr iterator erase(iterator loc)
+        {
+            u_node* block = loc.get();
+            const size_type index = loc.index;
+
+            if (block == nullptr || index >= block->count) return end();
+
+            T* spot = block->data() + index;
+            spot->~T();
+            relocate(spot, spot + 1, block->count - index - 1u);
+
+            --block->count;
+            --m_count;
+
+            if (block->count == 0u)
+            {
+                u_node* next = block->next;
+                unlink_block(block);
+
+                return next ? iterator{ next, 0u } : end();
+            }
+
+            if (block->count < min_fill)
+                return merge(block, index);
+
+            return normalize(block, index);
+        }
+
+        //Remove the first element.
+        constexpr void pop_front()
+        {
+            if (empty()) return;
+            erase(begin());
+        }
+
+        //Remove the last element.
+        constexpr void pop_back()
+        {
+            if (empty()) return;
+
+            u_node* tail = alloc.resource_rev();
+            erase(iterator{ tail, tail->count - 1u });
+        }
+
+        //Get the number of elements currently in the list.
+        constexpr size_type size() const { return m_count; }
+
+        //Get the number of blocks currently allocated.
+        constexpr size_type block_count() const { return m_blocks; }
+
+        //Remove all elements and free every block.
+        constexpr void clear()
+        {
+            u_node* block = alloc.resource();
+
+            while (block)
+            {
+                u_node* temp = block;
+                block = block->next;
+
+                for (size_type i = 0; i < temp->count; i++)
+                    temp->data()[i].~T();
+
+                temp->~u_node();
+                alloc.deallocate(temp, 1);
+            }
+
+            m_count = 0u;
+            m_blocks = 0u;
+            alloc.unlink();
+        }
+
+        //Get a pointer to the underlying allocator.
+        constexpr allocator_type* get_allocator() noexcept { return &alloc; }
+
+        //Get a pointer to the underlying allocator.
+        constexpr const allocator_type* get_allocator() const noexcept { return &alloc; }
+
+        //Get an iterator to the start of the list.
+        constexpr iterator begin() { return iterator{ alloc.resource(), 0u }; }
+
+        //Get an iterator to the start of the list.
+        constexpr const_iterator begin() const { return iterator{ alloc.resource(), 0u }; }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr iterator end()
+        {
+            u_node* tail = alloc.resource_rev();
+            return iterator{ tail, tail ? tail->count : 0u };
+        }
+
+        //Get an iterator to the location after the end of the list.
+        constexpr const_iterator end() const
+        {
+            u_node* tail = alloc.resource_rev();
+            return iterator{ tail, tail ? tail->count : 0u };
+        }
+
+        //Is the list empty?
+        [[nodiscard("This function does not empty the list.")]] constexpr bool empty() const
+        {
+            return m_count == 0u;
+        }
+    };
+
+    template<os_compatible T, std::size_t Size, standard_allocator Alloc>
+    inline constexpr std::ostream& operator<<(std::ostream& os, const unrolled_list<T, Size, Alloc>& list)
+    {
+        os << "{ ";
+
+        bool first_item = true;
+
+        for (auto& item : list)
+        {
+            if (first_item)
+                first_item = false;
+            else
+                os << ", ";
+
+            os << item;
+        }
+
+        os << " }";
+
+        return os;
+    }
+
+} // namespace aggro
+
+#endif // AGGRO_UNROLLED_LIST_HPP
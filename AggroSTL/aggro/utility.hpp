@@ -5,16 +5,27 @@
 
 namespace aggro
 {
+    //Size of a cache line on the platforms we target. Used to keep data shared between threads apart.
+    inline constexpr std::size_t cache_line_size = 64u;
+
     //Returns an rvalue reference of the provided value.
     template<typename T> requires (pointer<T> == false)
-    inline constexpr T&& move(T&& t) noexcept
+    inline constexpr std::remove_reference_t<T>&& move(T&& t) noexcept
+    {
+        return static_cast<std::remove_reference_t<T>&&>(t);
+    }
+
+    //Returns a forwarding reference of the provided value.
+    //Call it qualified as aggro::forward, since std::forward is found through argument-dependent lookup as well.
+    template<typename T>
+    inline constexpr T&& forward(std::remove_reference_t<T>& t) noexcept
     {
         return static_cast<T&&>(t);
     }
 
     //Returns a forwarding reference of the provided value.
     template<typename T>
-    inline constexpr T&& forward(T&& t) noexcept
+    inline constexpr T&& forward(std::remove_reference_t<T>&& t) noexcept
     {
         return static_cast<T&&>(t);
     }
@@ -39,6 +50,14 @@ namespace aggro
 
     };
 
+    //Key/value pair stored in the map containers.
+    template<typename K, typename V>
+    struct map_entry
+    {
+        K first;
+        V second;
+    };
+
     template<default_constructible T, default_constructible U>
     inline constexpr pair<T,U> make_pair(T&& t, U&& u)
     {
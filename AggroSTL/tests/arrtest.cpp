@@ -1,8 +1,27 @@
 #define AGGRO_MEMORY_PROFILE
 #include "array.hpp"
 #include "profile.hpp"
+#include "allocators/arena.hpp"
+#include "allocators/stats.hpp"
+#include "soa.hpp"
+#include "algorithm.hpp"
+#include "sort.hpp"
+#include "deque.hpp"
 #include <string>
 
+struct handle
+{
+    size_t id = 0u;
+    std::string* name = nullptr;
+
+    handle() = default;
+    handle(size_t i) : id(i) {}
+    handle(handle&& other) noexcept : id(other.id), name(other.name) { other.name = nullptr; }
+    ~handle() { delete name; }
+};
+
+template<>
+struct aggro::is_trivially_relocatable<handle> : std::true_type {};
 
 static void test_static_array([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
 {
@@ -43,10 +62,294 @@ static void test_dynamic_array([[maybe_unused]] aggro::bench_timer t, [[maybe_un
     fs.shrink_to_fit();
 }
 
+static void test_small_array([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::small_darray<std::string, 4> words = { "one", "two" };
+
+    words.emplace_back("three");
+    words.emplace_back("four");
+
+    std::cout << words << " inline capacity " << words.capacity() << "\n";
+
+    aggro::small_darray<std::string, 4> moved = aggro::move(words);
+
+    moved.emplace_back("five");
+
+    std::cout << moved << " spilled capacity " << moved.capacity() << "\n";
+
+    moved.pop_back();
+    moved.shrink_to_fit();
+
+    std::cout << moved << " shrunk capacity " << moved.capacity() << "\n";
+}
+
+static void test_relocatable_array([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::darray<handle> handles;
+
+    for(size_t n = 0u; n < 8u; ++n)
+        handles.emplace_back(n).name = new std::string("handle");
+
+    handles.erase(handles.begin() + 2, handles.begin() + 4);
+
+    std::cout << handles.size() << " handles, fourth id " << handles[3].id << "\n";
+}
+
+static void test_darray_pod_growth([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::darray<size_t> nums;
+    nums.expand_factor = 1.5f;
+
+    for(size_t n = 0u; n < 1000000u; ++n)
+        nums.emplace_back(n);
+
+    nums.erase(nums.begin(), nums.begin() + 1000u);
+    nums.shrink_to_fit();
+}
+
+static void test_darray_pod_growth_arena([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::memory_arena arena(8000000u);
+    aggro::darray<size_t, aggro::arena_contiguous_allocator<size_t>> nums;
+    nums.get_allocator()->set_arena(arena);
+    nums.expand_factor = 1.5f;
+
+    for(size_t n = 0u; n < 1000000u; ++n)
+        nums.emplace_back(n);
+}
+
+static void print_stats(const char* label, const aggro::allocator_stats& stats)
+{
+    std::cout << label << ": " << stats.allocations << " allocations, " << stats.reallocations << " reallocations, "
+        << stats.grows << " grows, " << stats.expansions << " expansions, largest block " << stats.largest_block << " bytes\n";
+}
+
+static void test_darray_stats([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::darray<int, aggro::stats_allocator<aggro::std_contiguous_allocator<int>>> grown;
+    aggro::darray<int, aggro::stats_allocator<aggro::std_contiguous_allocator<int>>> reserved;
+    aggro::darray<int, aggro::stats_allocator<aggro::inline_contiguous_allocator<int, 16>>> small;
+
+    reserved.reserve(1000u);
+
+    for(int n = 0; n < 1000; ++n)
+    {
+        grown.push_back(n);
+        reserved.push_back(n);
+    }
+
+    for(int n = 0; n < 20; ++n)
+        small.push_back(n);
+
+    print_stats("grown", grown.get_allocator()->stats());
+    print_stats("reserved", reserved.get_allocator()->stats());
+    print_stats("small", small.get_allocator()->stats());
+
+    aggro::memory_arena arena;
+    aggro::darray<int, aggro::stats_allocator<aggro::arena_contiguous_allocator<int>>> bumped;
+    bumped.get_allocator()->inner()->set_arena(arena);
+    bumped.expand_factor = 2.0f;
+
+    for(int n = 0; n < 1000; ++n)
+        bumped.push_back(n);
+
+    print_stats("arena", bumped.get_allocator()->stats());
+}
+
+static void test_soa_darray([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::soa_darray<float, std::string, int> units;
+    units.expand_factor = 2.0f;
+
+    units.push_back(1.5f, "archer", 3);
+    units.emplace_back(2.5f, "knight", 1);
+    units.emplace_back(0.5f, "scout", 7);
+
+    float total = 0.0f;
+    for(float speed : units.column<0>())
+        total += speed;
+
+    std::cout << "total speed " << total << "\n";
+
+    units.erase(0u);
+    units.get<1>(0u) += "!";
+
+    aggro::soa_darray<float, std::string, int> copy = units;
+
+    for(auto [speed, name, count] : copy)
+        std::cout << name << " " << speed << " x" << count << "\n";
+
+    std::cout << units.size() << " rows in " << units.bytes() << " bytes\n";
+}
+
+static void test_soa_darray_arena([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::memory_arena arena;
+    aggro::basic_soa_darray<aggro::arena_contiguous_allocator<unsigned char>, double, int> samples;
+    samples.get_allocator()->set_arena(arena);
+
+    //Leave the arena off an 8 byte boundary so the columns have to be aligned by hand.
+    [[maybe_unused]] void* odd = arena.allocate(3u, 1u);
+
+    for(int i = 0; i < 100; ++i)
+        samples.emplace_back(i * 0.25, i);
+
+    bool aligned = reinterpret_cast<std::uintptr_t>(samples.column<0>().data()) % alignof(double) == 0u;
+    double total = 0.0;
+
+    for(double value : samples.column<0>())
+        total += value;
+
+    std::cout << "total " << total << ", aligned: " << aligned << "\n";
+}
+
+static void test_darray_frames([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    for(size_t frame = 0u; frame < 10u; ++frame)
+    {
+        for(size_t i = 0u; i < 1000u; ++i)
+        {
+            aggro::darray<size_t> nums;
+            nums.expand_factor = 2.0f;
+
+            for(size_t n = 0u; n < 16u; ++n)
+                nums.emplace_back(n);
+        }
+    }
+}
+
+static void test_darray_frames_small([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    for(size_t frame = 0u; frame < 10u; ++frame)
+    {
+        for(size_t i = 0u; i < 1000u; ++i)
+        {
+            aggro::small_darray<size_t, 16> nums;
+            nums.expand_factor = 2.0f;
+
+            for(size_t n = 0u; n < 16u; ++n)
+                nums.emplace_back(n);
+        }
+    }
+}
+
+static void test_darray_frames_arena([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::memory_arena arena;
+
+    for(size_t frame = 0u; frame < 10u; ++frame)
+    {
+        for(size_t i = 0u; i < 1000u; ++i)
+        {
+            aggro::darray<size_t, aggro::arena_contiguous_allocator<size_t>> nums;
+            nums.get_allocator()->set_arena(arena);
+            nums.expand_factor = 2.0f;
+
+            for(size_t n = 0u; n < 16u; ++n)
+                nums.emplace_back(n);
+        }
+
+        arena.reset();
+    }
+}
+
+static void test_simd_algorithms([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::darray<int> ids;
+    ids.expand_factor = 2.0f;
+
+    for(int i = 0; i < 1003; ++i)
+        ids.push_back((i * 37) % 1000 - 500);
+
+    aggro::array<float, 13> speeds = { 1.5f, 2.0f, -0.5f, 4.0f, 2.0f, 8.5f, 0.0f, 3.0f, -0.5f, 2.0f, 1.0f, 7.0f, 2.5f };
+    const aggro::darray<int> same_ids = ids;
+
+    std::cout << "simd supported " << aggro::simd_level_name(aggro::simd_supported()) << "\n";
+
+    //Every level has to agree with the scalar loop.
+    for(aggro::simd_level level : { aggro::simd_level::scalar, aggro::simd_level::sse2, aggro::simd_level::avx2, aggro::simd_level::avx512 })
+    {
+        aggro::simd_limit(level);
+
+        auto slowest = aggro::min_element(speeds);
+        auto missing = aggro::find(same_ids, 12345);
+
+        std::cout << aggro::simd_level_name(aggro::simd_active())
+            << ": find " << aggro::find_index(ids, 499) << (missing ? " missing found" : "")
+            << ", count " << aggro::count(speeds, 2.0f) << " " << aggro::count(ids, -463)
+            << ", min " << *slowest << " at " << (&*slowest - speeds.data())
+            << ", max " << *aggro::max_element(ids)
+            << ", sum " << aggro::sum(ids) << " " << aggro::sum(speeds)
+            << ", equal " << aggro::equal(ids, same_ids) << "\n";
+    }
+
+    aggro::simd_limit(aggro::simd_supported());
+}
+
+static void test_sorting([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::darray<unsigned int> ids;
+    ids.expand_factor = 2.0f;
+
+    for(unsigned int i = 0u; i < 5000u; ++i)
+        ids.push_back((i * 2654435761u) >> 7);
+
+    aggro::darray<unsigned int> by_radix = ids;
+    aggro::sort_buffer<unsigned int> scratch;
+
+    aggro::sort(ids);
+    aggro::radix_sort(by_radix, scratch);
+
+    bool ordered = aggro::equal(ids, by_radix);
+
+    for(size_t i = 1u; i < ids.size(); ++i)
+        ordered = ordered && ids[i - 1u] <= ids[i];
+
+    std::cout << "5000 ids " << (ordered ? "sorted" : "out of order") << ", scratch holds " << scratch.capacity() << "\n";
+
+    aggro::array<float, 8> heights = { 2.5f, -1.0f, 0.0f, 7.25f, -0.0f, -3.5f, 1.0f, 2.5f };
+    aggro::sort(heights, std::greater<>());
+    std::cout << "heights descending " << heights << "\n";
+
+    aggro::deque<std::string, 4> names;
+    for(const char* name : { "knight", "archer", "scout", "mage", "healer", "bard" })
+        names.push_back(name);
+
+    aggro::sort(names);
+    std::cout << "names " << names << "\n";
+
+    //Records sorted by key keep their original order among equal keys.
+    struct unit { unsigned int team; int order; };
+
+    aggro::darray<unit> units;
+    units.expand_factor = 2.0f;
+
+    for(int i = 0; i < 400; ++i)
+        units.push_back(unit{ static_cast<unsigned int>(i * 7 % 3), i });
+
+    aggro::radix_sort(units, [](const unit& u) { return u.team; });
+    size_t first_of_team = 0u;
+    while(units[first_of_team].team == 0u)
+        ++first_of_team;
+
+    std::cout << "first of team 1 is unit " << units[first_of_team].order << "\n";
+}
 
 int main()
 {
     MEM_CHECK(test_static_array)
     MEM_CHECK(test_dynamic_array)
+    MEM_CHECK(test_small_array)
+    MEM_CHECK(test_relocatable_array)
+    MEM_CHECK(test_darray_pod_growth)
+    MEM_CHECK(test_darray_pod_growth_arena)
+    MEM_CHECK(test_darray_stats)
+    MEM_CHECK(test_soa_darray)
+    MEM_CHECK(test_soa_darray_arena)
+    MEM_CHECK(test_darray_frames)
+    MEM_CHECK(test_darray_frames_small)
+    MEM_CHECK(test_darray_frames_arena)
+    MEM_CHECK(test_simd_algorithms)
+    MEM_CHECK(test_sorting)
 
 }
\ No newline at end of file
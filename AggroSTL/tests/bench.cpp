@@ -0,0 +1,962 @@
+#include "bench.hpp"
+#include "array.hpp"
+#include "soa.hpp"
+#include "list.hpp"
+#include "unrolled_list.hpp"
+#include "deque.hpp"
+#include "hash_map.hpp"
+#include "flat_map.hpp"
+#include "slot_map.hpp"
+#include "sparse_set.hpp"
+#include "priority_queue.hpp"
+#include "parallel.hpp"
+#include "algorithm.hpp"
+#include "sort.hpp"
+#include "allocators/pool.hpp"
+#include <vector>
+#include <algorithm>
+#include <list>
+#include <deque>
+#include <map>
+#include <queue>
+#include <unordered_map>
+
+//Each AggroSTL case is registered right before its std counterpart, so they print side by side.
+
+static constexpr std::size_t lookup_stride = 7u;
+
+static void test_darray_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::darray<int> arr;
+        arr.expand_factor = 2.0f;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            arr.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(arr.data());
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void std_darray_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::vector<int> arr;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            arr.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(arr.data());
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void test_darray_iterate(aggro::bench::state& s)
+{
+    aggro::darray<int> arr(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        arr.push_back(static_cast<int>(i));
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        long long sum = 0;
+
+        for (int x : arr)
+            sum += x;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void std_darray_iterate(aggro::bench::state& s)
+{
+    std::vector<int> arr;
+    arr.reserve(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        arr.push_back(static_cast<int>(i));
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        long long sum = 0;
+
+        for (int x : arr)
+            sum += x;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+struct particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    int id;
+    int flags;
+};
+
+//Sums one field of each row. The darray of structs drags the other fields through the cache.
+static void test_darray_field_sum(aggro::bench::state& s)
+{
+    aggro::darray<particle> rows(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        rows.push_back(particle{ static_cast<float>(i), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, static_cast<int>(i), 0 });
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float sum = 0.0f;
+
+        for (const particle& p : rows)
+            sum += p.x;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_soa_field_sum(aggro::bench::state& s)
+{
+    aggro::soa_darray<float, float, float, float, float, float, int, int> rows(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        rows.push_back(static_cast<float>(i), 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, static_cast<int>(i), 0);
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float sum = 0.0f;
+
+        for (float x : rows.column<0>())
+            sum += x;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_dlist_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::dlist<int> list;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            list.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(list.front());
+    }
+}
+
+static void test_dlist_push_back_pooled(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::dlist<int, aggro::pooled_node_allocator<aggro::dnode<int>>> list;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            list.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(list.front());
+    }
+}
+
+static void std_dlist_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::list<int> list;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            list.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(list.front());
+    }
+}
+
+static void test_deque_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::deque<int, 128> deq;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            deq.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(deq.back());
+    }
+}
+
+static void std_deque_push_back(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::deque<int> deq;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            deq.push_back(static_cast<int>(i));
+
+        aggro::bench::do_not_optimize(deq.back());
+    }
+}
+
+static void test_hash_map_find(aggro::bench::state& s)
+{
+    aggro::flat_hash_map<std::size_t, std::size_t> table;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        table.insert(i * lookup_stride, i);
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t hits = 0u;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            if (table.find(i * lookup_stride)) ++hits;
+
+        aggro::bench::do_not_optimize(hits);
+    }
+}
+
+static void std_hash_map_find(aggro::bench::state& s)
+{
+    std::unordered_map<std::size_t, std::size_t> table;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        table.emplace(i * lookup_stride, i);
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t hits = 0u;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            if (table.find(i * lookup_stride) != table.end()) ++hits;
+
+        aggro::bench::do_not_optimize(hits);
+    }
+}
+
+static void test_flat_map_find(aggro::bench::state& s)
+{
+    aggro::flat_map<std::size_t, std::size_t> table;
+    std::vector<aggro::map_entry<std::size_t, std::size_t>> entries;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        entries.push_back({ i * lookup_stride, i });
+
+    table.insert_range(entries.begin(), entries.end());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t hits = 0u;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            if (table.find(i * lookup_stride)) ++hits;
+
+        aggro::bench::do_not_optimize(hits);
+    }
+}
+
+static void std_flat_map_find(aggro::bench::state& s)
+{
+    std::map<std::size_t, std::size_t> table;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        table.emplace(i * lookup_stride, i);
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t hits = 0u;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            if (table.find(i * lookup_stride) != table.end()) ++hits;
+
+        aggro::bench::do_not_optimize(hits);
+    }
+}
+
+//Keeps 'range' objects alive while replacing one in four every iteration, then sums them.
+static void test_slot_map_churn(aggro::bench::state& s)
+{
+    aggro::slot_map<std::size_t> objects;
+    std::vector<aggro::slot_handle> handles;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        handles.push_back(objects.insert(i));
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        for (std::size_t i = 0; i < s.range(); i += 4u)
+        {
+            objects.erase(handles[i]);
+            handles[i] = objects.insert(i);
+        }
+
+        std::size_t sum = 0u;
+
+        for (std::size_t value : objects)
+            sum += value;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void std_slot_map_churn(aggro::bench::state& s)
+{
+    std::unordered_map<std::size_t, std::size_t> objects;
+    std::vector<std::size_t> handles;
+    std::size_t next_id = 0u;
+
+    for (std::size_t i = 0; i < s.range(); i++)
+    {
+        objects.emplace(next_id, i);
+        handles.push_back(next_id++);
+    }
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        for (std::size_t i = 0; i < s.range(); i += 4u)
+        {
+            objects.erase(handles[i]);
+            objects.emplace(next_id, i);
+            handles[i] = next_id++;
+        }
+
+        std::size_t sum = 0u;
+
+        for (const auto& entry : objects)
+            sum += entry.second;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+//Fills two component sets with the same ids in different orders.
+static void fill_components(aggro::sparse_set<float>& positions, aggro::sparse_set<float>& velocities, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++)
+    {
+        positions.emplace(static_cast<std::uint32_t>(i), 1.0f);
+        velocities.emplace(static_cast<std::uint32_t>((i * 7919u) % count), 2.0f);
+    }
+}
+
+//Joins two component sets after sort_as(), walking both packed arrays front to back.
+static void test_sparse_set_join(aggro::bench::state& s)
+{
+    aggro::sparse_set<float> positions;
+    aggro::sparse_set<float> velocities;
+    fill_components(positions, velocities, s.range());
+
+    velocities.sort_as(positions);
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float* pos = positions.data();
+        const float* vel = velocities.data();
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            pos[i] += vel[i];
+
+        aggro::bench::clobber_memory();
+    }
+}
+
+//The same join without sorting, looking every id up in the second set.
+static void test_sparse_set_join_unsorted(aggro::bench::state& s)
+{
+    aggro::sparse_set<float> positions;
+    aggro::sparse_set<float> velocities;
+    fill_components(positions, velocities, s.range());
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float* pos = positions.data();
+        const float* vel = velocities.data();
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            pos[i] += vel[velocities.index_of(positions.entities()[i])];
+
+        aggro::bench::clobber_memory();
+    }
+}
+
+//Pseudo-random timestamps for the queue benchmarks.
+static std::vector<std::uint32_t> make_timestamps(std::size_t count)
+{
+    std::vector<std::uint32_t> stamps;
+    stamps.reserve(count);
+
+    std::uint32_t x = 12345u;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        x = x * 1664525u + 1013904223u;
+        stamps.push_back(x >> 8);
+    }
+
+    return stamps;
+}
+
+//Pushes 'range' timestamps one at a time and pops them all.
+template<std::size_t Arity>
+static void test_priority_queue_push_pop(aggro::bench::state& s)
+{
+    const std::vector<std::uint32_t> stamps = make_timestamps(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::priority_queue<std::uint32_t, std::greater<std::uint32_t>, Arity> queue;
+        queue.reserve(s.range());
+
+        for (std::uint32_t stamp : stamps)
+            queue.push(stamp);
+
+        std::uint32_t sum = 0u;
+
+        while (auto next = queue.pop())
+            sum += *next;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_priority_queue_push_pop_4(aggro::bench::state& s) { test_priority_queue_push_pop<4u>(s); }
+static void test_priority_queue_push_pop_2(aggro::bench::state& s) { test_priority_queue_push_pop<2u>(s); }
+
+static void std_priority_queue_push_pop(aggro::bench::state& s)
+{
+    const std::vector<std::uint32_t> stamps = make_timestamps(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::vector<std::uint32_t> storage;
+        storage.reserve(s.range());
+        std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> queue(std::greater<std::uint32_t>(), std::move(storage));
+
+        for (std::uint32_t stamp : stamps)
+            queue.push(stamp);
+
+        std::uint32_t sum = 0u;
+
+        while (!queue.empty())
+        {
+            sum += queue.top();
+            queue.pop();
+        }
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+//Builds the queue from the whole batch at once and pops it.
+static void test_priority_queue_push_range(aggro::bench::state& s)
+{
+    const std::vector<std::uint32_t> stamps = make_timestamps(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::priority_queue<std::uint32_t, std::greater<std::uint32_t>> queue;
+        queue.push_range(stamps.begin(), stamps.end());
+
+        std::uint32_t sum = 0u;
+
+        while (auto next = queue.pop())
+            sum += *next;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void std_priority_queue_push_range(aggro::bench::state& s)
+{
+    const std::vector<std::uint32_t> stamps = make_timestamps(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> queue(stamps.begin(), stamps.end());
+
+        std::uint32_t sum = 0u;
+
+        while (!queue.empty())
+        {
+            sum += queue.top();
+            queue.pop();
+        }
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+//Builds a list, inserts before every fourth element in one pass, then sums it.
+template<typename List>
+static void list_insert_walk(aggro::bench::state& s)
+{
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        List list;
+
+        for (std::size_t i = 0; i < s.range(); i++)
+            list.push_back(static_cast<int>(i));
+
+        std::size_t n = 0u;
+
+        for (auto it = list.begin(); it != list.end(); ++it)
+        {
+            if (++n % 4u == 0u)
+            {
+                it = list.insert(it, -1);
+                ++it;
+            }
+        }
+
+        long long sum = 0;
+
+        for (int x : list)
+            sum += x;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_unrolled_list_insert_walk(aggro::bench::state& s) { list_insert_walk<aggro::unrolled_list<int, 32>>(s); }
+static void test_dlist_insert_walk(aggro::bench::state& s) { list_insert_walk<aggro::dlist<int>>(s); }
+static void std_list_insert_walk(aggro::bench::state& s) { list_insert_walk<std::list<int>>(s); }
+
+//One job system shared by every parallel case, owned by the benchmark thread.
+static aggro::job_system& bench_jobs()
+{
+    static aggro::job_system jobs;
+    return jobs;
+}
+
+static aggro::darray<float> make_floats(std::size_t count)
+{
+    aggro::darray<float> values;
+    values.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++)
+        values.push_back(static_cast<float>(i % 1024u) * 0.5f);
+
+    return values;
+}
+
+static void test_parallel_reduce(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+        aggro::bench::do_not_optimize(aggro::parallel_reduce(bench_jobs(), values, 0.0f));
+}
+
+static void serial_reduce(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float sum = 0.0f;
+
+        for (float v : values)
+            sum += v;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_parallel_transform(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    aggro::darray<float> out = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::parallel_transform(bench_jobs(), values, out, [](float v) { return v * 1.5f + 2.0f; });
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void serial_transform(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    aggro::darray<float> out = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        for (std::size_t i = 0; i < values.size(); i++)
+            out[i] = values[i] * 1.5f + 2.0f;
+
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void test_parallel_scan(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    aggro::darray<float> out = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        aggro::parallel_inclusive_scan(bench_jobs(), values, out);
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void serial_scan(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    aggro::darray<float> out = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        float sum = 0.0f;
+
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            sum += values[i];
+            out[i] = sum;
+        }
+
+        aggro::bench::clobber_memory();
+    }
+}
+
+static aggro::darray<int> make_ids(std::size_t count)
+{
+    aggro::darray<int> ids;
+    ids.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++)
+        ids.push_back(static_cast<int>(i % 100000u));
+
+    return ids;
+}
+
+//Searches for a value that is not there, so every element is compared.
+static void test_simd_find(aggro::bench::state& s)
+{
+    aggro::darray<int> ids = make_ids(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+        aggro::bench::do_not_optimize(aggro::find_index(ids, -1));
+}
+
+static void scalar_find(aggro::bench::state& s)
+{
+    aggro::darray<int> ids = make_ids(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t i = 0;
+        aggro::bench::do_not_optimize(ids.data());
+
+        while (i < ids.size() && ids[i] != -1)
+            i++;
+
+        aggro::bench::do_not_optimize(i);
+    }
+}
+
+static void test_simd_count(aggro::bench::state& s)
+{
+    aggro::darray<int> ids = make_ids(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+        aggro::bench::do_not_optimize(aggro::count(ids, 7));
+}
+
+static void scalar_count(aggro::bench::state& s)
+{
+    aggro::darray<int> ids = make_ids(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t found = 0u;
+        aggro::bench::do_not_optimize(ids.data());
+
+        for (int id : ids)
+            found += (id == 7) ? 1u : 0u;
+
+        aggro::bench::do_not_optimize(found);
+    }
+}
+
+static void test_simd_min(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+        aggro::bench::do_not_optimize(aggro::min_index(values.data(), values.size()));
+}
+
+static void scalar_min(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::size_t best = 0u;
+        aggro::bench::do_not_optimize(values.data());
+
+        for (std::size_t i = 1u; i < values.size(); i++)
+            if (values[i] < values[best]) best = i;
+
+        aggro::bench::do_not_optimize(best);
+    }
+}
+
+static void test_simd_sum(aggro::bench::state& s)
+{
+    aggro::darray<float> values = make_floats(s.range());
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+        aggro::bench::do_not_optimize(aggro::sum(values));
+}
+
+//Random entity IDs, the same sequence every run.
+static aggro::darray<std::uint32_t> make_random_ids(std::size_t count)
+{
+    aggro::darray<std::uint32_t> ids;
+    ids.reserve(count);
+
+    std::uint32_t state = 2463534242u;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        ids.push_back(state);
+    }
+
+    return ids;
+}
+
+//Each iteration restores the unsorted IDs before sorting, in both the aggro and std cases.
+template<typename Sort>
+static void sort_ids(aggro::bench::state& s, Sort sort)
+{
+    const aggro::darray<std::uint32_t> source = make_random_ids(s.range());
+    aggro::darray<std::uint32_t> ids = source;
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        for (std::size_t i = 0; i < ids.size(); i++)
+            ids[i] = source[i];
+
+        sort(ids);
+        aggro::bench::clobber_memory();
+    }
+}
+
+static void test_sort(aggro::bench::state& s)
+{
+    sort_ids(s, [](aggro::darray<std::uint32_t>& ids) { aggro::sort(ids); });
+}
+
+static void test_radix_sort(aggro::bench::state& s)
+{
+    aggro::sort_buffer<std::uint32_t> scratch;
+    sort_ids(s, [&scratch](aggro::darray<std::uint32_t>& ids) { aggro::radix_sort(ids, scratch); });
+}
+
+static void std_sort(aggro::bench::state& s)
+{
+    sort_ids(s, [](aggro::darray<std::uint32_t>& ids) { std::sort(ids.begin(), ids.end()); });
+}
+
+//Refills a list with the same random ids every iteration and sorts it in place.
+template<typename List>
+static void list_sort(aggro::bench::state& s)
+{
+    const aggro::darray<std::uint32_t> source = make_random_ids(s.range());
+    List list;
+    s.set_ops_per_iteration(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        list.push_back(source[i]);
+
+    while (s.keep_running())
+    {
+        std::size_t i = 0u;
+
+        for (std::uint32_t& id : list)
+            id = source[i++];
+
+        list.sort();
+        aggro::bench::do_not_optimize(list.front());
+    }
+}
+
+//Copies a list and walks the copy.
+template<typename List>
+static void list_copy_walk(aggro::bench::state& s)
+{
+    const aggro::darray<std::uint32_t> source = make_random_ids(s.range());
+    List list;
+    s.set_ops_per_iteration(s.range());
+
+    for (std::size_t i = 0; i < s.range(); i++)
+        list.push_back(source[i]);
+
+    while (s.keep_running())
+    {
+        List copy = list;
+        std::uint64_t sum = 0u;
+
+        for (std::uint32_t id : copy)
+            sum += id;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_dlist_copy_walk(aggro::bench::state& s) { list_copy_walk<aggro::dlist<std::uint32_t>>(s); }
+static void test_dlist_copy_walk_pooled(aggro::bench::state& s)
+{
+    list_copy_walk<aggro::dlist<std::uint32_t, aggro::pooled_node_allocator<aggro::dnode<std::uint32_t>>>>(s);
+}
+static void std_list_copy_walk(aggro::bench::state& s) { list_copy_walk<std::list<std::uint32_t>>(s); }
+
+//Walks a list whose nodes were scattered by sorting random ids, optionally compacting it first.
+template<bool Compact>
+static void dlist_walk_sorted(aggro::bench::state& s)
+{
+    aggro::dlist<std::uint32_t, aggro::pooled_node_allocator<aggro::dnode<std::uint32_t>>> list;
+    list.append_range(make_random_ids(s.range()));
+    list.sort();
+
+    if constexpr (Compact)
+        list.compact();
+
+    s.set_ops_per_iteration(s.range());
+
+    while (s.keep_running())
+    {
+        std::uint64_t sum = 0u;
+
+        for (std::uint32_t id : list)
+            sum += id;
+
+        aggro::bench::do_not_optimize(sum);
+    }
+}
+
+static void test_dlist_walk_compacted(aggro::bench::state& s) { dlist_walk_sorted<true>(s); }
+static void test_dlist_walk_scattered(aggro::bench::state& s) { dlist_walk_sorted<false>(s); }
+
+static void test_dlist_sort(aggro::bench::state& s) { list_sort<aggro::dlist<std::uint32_t>>(s); }
+static void std_list_sort(aggro::bench::state& s) { list_sort<std::list<std::uint32_t>>(s); }
+
+AGGRO_BENCHMARK(test_darray_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_darray_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_darray_iterate, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_darray_iterate, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_darray_field_sum, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_soa_field_sum, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_dlist_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_dlist_push_back_pooled, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_dlist_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_deque_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_deque_push_back, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_hash_map_find, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_hash_map_find, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_flat_map_find, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_flat_map_find, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_slot_map_churn, 256, 4096, 65536)
+AGGRO_BENCHMARK(std_slot_map_churn, 256, 4096, 65536)
+AGGRO_BENCHMARK(test_priority_queue_push_pop_4, 256, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_priority_queue_push_pop_2, 256, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(std_priority_queue_push_pop, 256, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_priority_queue_push_range, 256, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(std_priority_queue_push_range, 256, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_sparse_set_join, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_sparse_set_join_unsorted, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_unrolled_list_insert_walk, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_dlist_insert_walk, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(std_list_insert_walk, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_parallel_reduce, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(serial_reduce, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(test_parallel_transform, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(serial_transform, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(test_parallel_scan, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(serial_scan, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(test_simd_find, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(scalar_find, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_simd_count, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(scalar_count, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_simd_min, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(scalar_min, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_simd_sum, 65536, 1048576, 4194304)
+AGGRO_BENCHMARK(test_sort, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_radix_sort, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(std_sort, 4096, 65536, 1048576)
+AGGRO_BENCHMARK(test_dlist_sort, 4096, 65536)
+AGGRO_BENCHMARK(std_list_sort, 4096, 65536)
+AGGRO_BENCHMARK(test_dlist_copy_walk, 4096, 65536)
+AGGRO_BENCHMARK(test_dlist_copy_walk_pooled, 4096, 65536)
+AGGRO_BENCHMARK(std_list_copy_walk, 4096, 65536)
+AGGRO_BENCHMARK(test_dlist_walk_compacted, 65536, 1048576)
+AGGRO_BENCHMARK(test_dlist_walk_scattered, 65536, 1048576)
+
+int main(int argc, char** argv)
+{
+    return aggro::bench::run(argc, argv);
+}
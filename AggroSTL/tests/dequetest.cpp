@@ -0,0 +1,93 @@
+#define AGGRO_MEMORY_PROFILE
+#include "profile.hpp"
+#include "deque.hpp"
+#include <string>
+#include <deque>
+
+static void test_deque_with_strings([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::deque<std::string, 4> words;
+
+    words.push_back("three");
+    words.push_back("four");
+    words.push_front("two");
+    words.push_front("one");
+    words.emplace_back("five");
+    words.emplace_front("zero");
+
+    std::cout << words << "\n";
+
+    words.pop_front();
+    words.pop_back();
+
+    std::cout << words << "\n";
+
+    auto third = words.at(2);
+    auto missing = words.at(10);
+
+    if(third && !missing)
+    {
+        *third = "THREE";
+    }
+
+    for(auto it = words.begin() + 1; it != words.end(); ++it)
+        std::cout << *it << " ";
+
+    std::cout << "\n";
+}
+
+static void test_deque_random_access([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::deque<size_t, 64> nums;
+
+    for(size_t i = 0u; i < 50000u; ++i)
+    {
+        nums.push_back(i);
+        nums.push_front(i);
+    }
+
+    size_t sum = 0u;
+
+    for(size_t i = 0u; i < nums.size(); i += 7u)
+        sum += nums[i];
+
+    while(!nums.empty())
+    {
+        nums.pop_front();
+        if(!nums.empty()) nums.pop_back();
+    }
+
+    std::cout << "sum " << sum << "\n";
+}
+
+static void std_deque_random_access([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    std::deque<size_t> nums;
+
+    for(size_t i = 0u; i < 50000u; ++i)
+    {
+        nums.push_back(i);
+        nums.push_front(i);
+    }
+
+    size_t sum = 0u;
+
+    for(size_t i = 0u; i < nums.size(); i += 7u)
+        sum += nums[i];
+
+    while(!nums.empty())
+    {
+        nums.pop_front();
+        if(!nums.empty()) nums.pop_back();
+    }
+
+    std::cout << "sum " << sum << "\n";
+}
+
+
+int main()
+{
+    MEM_CHECK(test_deque_with_strings)
+    MEM_CHECK(test_deque_random_access)
+    MEM_CHECK(std_deque_random_access)
+}
@@ -1,6 +1,12 @@
 #define AGGRO_MEMORY_PROFILE
 #include "profile.hpp"
 #include "list.hpp"
+#include "array.hpp"
+#include "intrusive_list.hpp"
+#include "unrolled_list.hpp"
+#include "allocators/arena.hpp"
+#include "allocators/pool.hpp"
+#include "allocators/stats.hpp"
 #include <string>
 #include <forward_list>
 #include <list>
@@ -75,6 +81,30 @@ static void test_list_from_empty([[maybe_unused]] aggro::bench_timer t, [[maybe_
 
 }
 
+static void test_list_from_empty_pooled([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::node_pool<aggro::snode<size_t>> single_pool;
+    aggro::node_pool<aggro::dnode<size_t>> dub_pool;
+
+    aggro::slist<size_t, aggro::pooled_node_allocator<aggro::snode<size_t>>> single;
+    aggro::dlist<size_t, aggro::pooled_node_allocator<aggro::dnode<size_t>>> dub;
+    single.get_allocator()->set_pool(single_pool);
+    dub.get_allocator()->set_pool(dub_pool);
+
+    for(size_t i = 0u; i < 1000u; ++i)
+    {
+        if(i % 4u == 3u)
+        {
+            dub.pop_front();
+            single.erase_after(single.begin());
+        }
+        
+        dub.emplace_back(i);
+        single.emplace_front(i);
+    }
+
+}
+
 static void std_list_from_empty([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
 {
     std::forward_list<size_t> single;
@@ -94,6 +124,344 @@ static void std_list_from_empty([[maybe_unused]] aggro::bench_timer t, [[maybe_u
 
 }
 
+static void test_list_stats([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::dlist<std::string, aggro::stats_allocator<aggro::std_node_allocator<aggro::dnode<std::string>>>> names = { "cat", "dog" };
+    aggro::slist<int, aggro::stats_allocator<aggro::pooled_node_allocator<aggro::snode<int>>>> nums;
+
+    names.push_back("owl");
+    names.push_front("ant");
+    names.pop_back();
+
+    for(int n = 0; n < 100; ++n)
+        nums.push_front(n);
+
+    const aggro::allocator_stats& name_stats = names.get_allocator()->stats();
+    const aggro::allocator_stats& num_stats = nums.get_allocator()->stats();
+
+    std::cout << names << "\n";
+    std::cout << "dlist: " << name_stats.allocations << " allocations, " << name_stats.deallocations << " deallocations, "
+        << name_stats.live_bytes() << " bytes live\n";
+    std::cout << "slist: " << num_stats.allocations << " allocations, largest block " << num_stats.largest_block << " bytes\n";
+}
+
+static void test_list_frames([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    for(size_t frame = 0u; frame < 10u; ++frame)
+    {
+        for(size_t i = 0u; i < 1000u; ++i)
+        {
+            aggro::slist<size_t> single;
+            aggro::dlist<size_t> dub;
+
+            for(size_t n = 0u; n < 16u; ++n)
+            {
+                single.emplace_front(n);
+                dub.emplace_back(n);
+            }
+        }
+    }
+}
+
+static void test_list_frames_arena([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::memory_arena arena;
+
+    for(size_t frame = 0u; frame < 10u; ++frame)
+    {
+        for(size_t i = 0u; i < 1000u; ++i)
+        {
+            aggro::slist<size_t, aggro::arena_node_allocator<aggro::snode<size_t>>> single;
+            aggro::dlist<size_t, aggro::arena_node_allocator<aggro::dnode<size_t>>> dub;
+            single.get_allocator()->set_arena(arena);
+            dub.get_allocator()->set_arena(arena);
+
+            for(size_t n = 0u; n < 16u; ++n)
+            {
+                single.emplace_front(n);
+                dub.emplace_back(n);
+            }
+        }
+
+        arena.reset();
+    }
+}
+
+struct job
+{
+    int id = 0;
+    aggro::idlist_hook ready;
+    aggro::idlist_hook all;
+    aggro::islist_hook free;
+
+    job() = default;
+    job(int i) : id(i) {}
+};
+
+inline std::ostream& operator<<(std::ostream& os, const job& j) { return os << j.id; }
+
+static void test_intrusive_lists([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    job jobs[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    aggro::intrusive_dlist<job, &job::all> all;
+    aggro::intrusive_dlist<job, &job::ready> ready;
+    aggro::intrusive_slist<job, &job::free> free_list;
+
+    for(job& j : jobs)
+    {
+        all.push_back(j);
+
+        if(j.id % 2 == 0)
+            ready.push_front(j);
+        else
+            free_list.push_back(j);
+    }
+
+    std::cout << all << "\n" << ready << "\n" << free_list << "\n";
+
+    //Unlinking from one list leaves the object in the others.
+    ready.remove(jobs[4]);
+    all.erase(all.iterator_to(jobs[3]));
+    ready.insert(ready.iterator_to(jobs[0]), jobs[4]);
+    free_list.erase_after(free_list.begin());
+    free_list.pop_front();
+    free_list.insert_after(free_list.before_begin(), jobs[3]);
+
+    std::cout << all << "\n" << ready << "\n" << free_list << "\n";
+    std::cout << "back of all: " << all.back() << ", last before end: " << *(--all.end()) << ", job 3 in all: "
+        << jobs[3].all.is_linked() << ", sizes: " << all.size() << " " << ready.size() << " " << free_list.size() << "\n";
+
+    aggro::intrusive_dlist<job, &job::all> moved = aggro::move(all);
+    moved.pop_front();
+    moved.pop_back();
+
+    std::cout << moved << " " << all << "\n";
+}
+
+static void test_unrolled_list_with_strings([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::unrolled_list<std::string, 4> words = { "one", "two", "three", "four", "five" };
+
+    std::cout << words << "\n";
+
+    words.insert(words.begin() + 2, "cat");
+    words.insert(words.begin() + 2, "dog");
+
+    std::cout << words << "\n";
+
+    words.erase(words.begin() + 1);
+    words.pop_front();
+    words.push_front("fish");
+    words.pop_back();
+
+    std::cout << words << "\n";
+    std::cout << "last: " << *(--words.end()) << ", " << words.size() << " words in " << words.block_count() << " blocks\n";
+}
+
+//Inserts into the middle of a growing sequence, then walks it.
+template<typename List>
+static size_t fill_middle(List& list, size_t count)
+{
+    for(size_t i = 0u; i < count; ++i)
+    {
+        auto it = list.begin();
+
+        for(size_t n = 0u; n < list.size() / 2u; ++n)
+            ++it;
+
+        list.insert(it, i);
+    }
+
+    size_t sum = 0u;
+
+    for(size_t value : list)
+        sum += value;
+
+    return sum;
+}
+
+static void test_unrolled_list_middle([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::unrolled_list<size_t, 32> list;
+
+    std::cout << fill_middle(list, 2000u) << " in " << list.block_count() << " blocks\n";
+}
+
+static void test_dlist_middle([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::dlist<size_t> list;
+
+    std::cout << fill_middle(list, 2000u) << "\n";
+}
+
+static void test_list_splice_and_sort([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::dlist<int> ready = { 5, 1, 4, 1, 3 };
+    aggro::dlist<int> blocked = { 9, 2, 6 };
+
+    //Move one task, then the rest of the blocked queue, onto the ready queue without touching the heap.
+    ready.splice(ready.begin(), blocked, blocked.begin() + 1);
+    ready.splice(ready.end(), blocked);
+    blocked.splice(blocked.end(), ready, ready.begin() + 2, ready.begin() + 4);
+
+    std::cout << ready << " " << blocked << " sizes: " << ready.size() << " " << blocked.size() << "\n";
+
+    ready.sort();
+    blocked.sort(std::greater<>{});
+    blocked.reverse();
+    ready.merge(blocked);
+
+    std::cout << ready << " back: " << ready.back() << ", removed " << ready.unique() << " -> " << ready << "\n";
+
+    ready.reverse();
+    std::cout << ready << " front: " << ready.front() << ", back: " << ready.back() << "\n";
+
+    aggro::slist<std::string> words = { "pear", "fig", "apple", "fig", "kiwi" };
+    aggro::slist<std::string> more = { "date", "banana" };
+
+    words.splice_after(words.end(), more, more.end());
+    words.splice_after(words.begin() + 2, more);
+    words.sort();
+
+    std::cout << words << " removed " << words.unique() << " -> ";
+
+    words.reverse();
+    std::cout << words << " sizes: " << words.size() << " " << more.size() << "\n";
+}
+
+static void test_list_ranges([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    using pooled_dnode = aggro::stats_allocator<aggro::pooled_node_allocator<aggro::dnode<std::string>>>;
+
+    aggro::dlist<std::string, pooled_dnode> names = { "cat", "dog", "owl", "ant" };
+    aggro::dlist<std::string, pooled_dnode> copy = names;
+    aggro::slist<int> nums = { 1, 2, 3 };
+    aggro::darray<int> more = { 7, 8, 9 };
+
+    copy.insert_range(copy.begin() + 2, aggro::slist<std::string>{ "bee", "elk" });
+    copy.append_range(names);
+    nums.insert_range_after(nums.begin(), more);
+    nums.append_range(std::initializer_list<int>{ 4, 5 });
+    nums.insert_range_after(nums.end(), aggro::darray<int>{});
+
+    //Batched nodes sit next to each other in list order.
+    bool contiguous = true;
+    const aggro::dnode<std::string>* prev = nullptr;
+
+    for(auto it = names.begin(); it != names.end(); ++it)
+    {
+        if(prev && it.get() != prev + 1) contiguous = false;
+        prev = it.get();
+    }
+
+    std::cout << copy << " " << copy.size() << " back: " << copy.back() << "\n" << nums << " " << nums.size() << "\n";
+    std::cout << "allocations: " << names.get_allocator()->stats().allocations << " " << copy.get_allocator()->stats().allocations
+        << ", contiguous: " << contiguous << "\n";
+}
+
+static void test_list_compact([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::node_pool<aggro::dnode<std::string>> pool;
+    aggro::dlist<std::string, aggro::pooled_node_allocator<aggro::dnode<std::string>>> words;
+    aggro::slist<int> nums;
+    words.get_allocator()->set_pool(pool);
+
+    for(int i = 0; i < 12; ++i)
+    {
+        words.push_front(std::to_string(i));
+        nums.push_front(i);
+
+        if(i % 3 == 2)
+            words.erase(words.begin() + 1);
+    }
+
+    words.sort();
+    nums.sort();
+    words.compact();
+    nums.compact();
+
+    bool contiguous = true;
+
+    for(const aggro::dnode<std::string>* node = words.begin().get(); node->next; node = node->next)
+    {
+        if(node->next != node + 1) contiguous = false;
+    }
+
+    std::cout << words << " back: " << words.back() << ", contiguous: " << contiguous << "\n";
+
+    words.reverse();
+    std::cout << words << " " << words.size() << "\n" << nums << " " << nums.size() << "\n";
+}
+
+static void test_list_move_pooled([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    //These draw from the thread's local pool.
+    aggro::dlist<size_t, aggro::pooled_node_allocator<aggro::dnode<size_t>>> local_dub;
+    aggro::slist<size_t, aggro::pooled_node_allocator<aggro::snode<size_t>>> local_single;
+
+    {
+        aggro::node_pool<aggro::dnode<size_t>> dub_pool;
+        aggro::node_pool<aggro::snode<size_t>> single_pool;
+
+        aggro::dlist<size_t, aggro::pooled_node_allocator<aggro::dnode<size_t>>> dub;
+        aggro::slist<size_t, aggro::pooled_node_allocator<aggro::snode<size_t>>> single;
+        dub.get_allocator()->set_pool(dub_pool);
+        single.get_allocator()->set_pool(single_pool);
+
+        for(size_t i = 0u; i < 3u; ++i)
+        {
+            dub.push_back(i);
+            single.push_front(i);
+        }
+
+        //The moved-to lists must return their nodes to the pools they came from, not to the thread's local pool.
+        aggro::dlist<size_t, aggro::pooled_node_allocator<aggro::dnode<size_t>>> moved_dub = aggro::move(dub);
+        aggro::slist<size_t, aggro::pooled_node_allocator<aggro::snode<size_t>>> moved_single = aggro::move(single);
+
+        std::cout << moved_dub << " " << moved_single << " from the same pool: "
+            << (moved_dub.get_allocator()->pool() == &dub_pool && moved_single.get_allocator()->pool() == &single_pool)
+            << ", left behind: " << dub.size() << " " << single.size() << "\n";
+    }
+
+    for(size_t i = 0u; i < 100u; ++i)
+    {
+        local_dub.push_back(i);
+        local_single.push_front(i);
+    }
+
+    std::cout << local_dub.size() << " " << local_single.size() << "\n";
+}
+
+static void test_unrolled_list_move_pooled([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    using pooled_block = aggro::pooled_node_allocator<aggro::unode<size_t, 8>>;
+
+    //Draws from the thread's local pool.
+    aggro::unrolled_list<size_t, 8, pooled_block> local;
+
+    {
+        aggro::node_pool<aggro::unode<size_t, 8>> pool;
+        aggro::unrolled_list<size_t, 8, pooled_block> list;
+        aggro::unrolled_list<size_t, 8, pooled_block> assigned;
+        list.get_allocator()->set_pool(pool);
+
+        for(size_t i = 0u; i < 20u; ++i)
+            list.push_back(i);
+
+        //Both moves must keep returning blocks to 'pool', not to the local pool.
+        aggro::unrolled_list<size_t, 8, pooled_block> moved = aggro::move(list);
+        assigned = aggro::move(moved);
+
+        std::cout << assigned.size() << " values in " << assigned.block_count() << " blocks, same pool: "
+            << (assigned.get_allocator()->pool() == &pool) << ", left behind: " << list.size() << " " << moved.size() << "\n";
+    }
+
+    for(size_t i = 0u; i < 100u; ++i)
+        local.push_back(i);
+
+    std::cout << local.size() << "\n";
+}
 
 int main()
 {
@@ -101,6 +469,19 @@ int main()
     MEM_CHECK(test_slist_with_pod)
     MEM_CHECK(test_dlist_with_strings)
     MEM_CHECK(test_list_from_empty)
+    MEM_CHECK(test_list_from_empty_pooled)
     MEM_CHECK(std_list_from_empty)
+    MEM_CHECK(test_list_stats)
+    MEM_CHECK(test_list_frames)
+    MEM_CHECK(test_list_frames_arena)
+    MEM_CHECK(test_intrusive_lists)
+    MEM_CHECK(test_unrolled_list_with_strings)
+    MEM_CHECK(test_unrolled_list_middle)
+    MEM_CHECK(test_dlist_middle)
+    MEM_CHECK(test_list_splice_and_sort)
+    MEM_CHECK(test_list_ranges)
+    MEM_CHECK(test_list_compact)
+    MEM_CHECK(test_list_move_pooled)
+    MEM_CHECK(test_unrolled_list_move_pooled)
     
 }
@@ -0,0 +1,270 @@
+#define AGGRO_MEMORY_PROFILE
+#include "profile.hpp"
+#include "hash_map.hpp"
+#include "flat_map.hpp"
+#include "slot_map.hpp"
+#include "sparse_set.hpp"
+#include <string>
+#include <unordered_map>
+#include <map>
+
+static constexpr size_t key_count = 200000u;
+
+//Prints the time since 'start' and restarts it.
+static void lap(const char* phase, std::chrono::steady_clock::time_point& start)
+{
+    auto now = std::chrono::steady_clock::now();
+    std::cout << phase << " " << std::chrono::duration_cast<std::chrono::microseconds>(now - start).count() << " microseconds\n";
+    start = now;
+}
+
+static void test_hash_map_with_strings([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::flat_hash_map<std::string, int> ages = { { "cat", 3 }, { "dog", 5 } };
+
+    ages.insert("fish", 1);
+    ages["owl"] = 7;
+
+    if(!ages.insert("cat", 10))
+        std::cout << "cat already present\n";
+
+    auto dog = ages.find("dog");
+    auto cow = ages.find("cow");
+
+    if(dog && !cow)
+        *dog = 6;
+
+    ages.erase("fish");
+
+    for(auto& entry : ages)
+        std::cout << entry.first << " " << entry.second << "\n";
+}
+
+static void test_hash_map_lookup([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    auto start = std::chrono::steady_clock::now();
+    aggro::flat_hash_map<size_t, size_t> table;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        table.insert(i * 7u, i);
+
+    lap("insert", start);
+    size_t hits = 0u;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u)) ++hits;
+
+    lap("hit", start);
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u + 1u)) ++hits;
+
+    lap("miss", start);
+    std::cout << hits << " hits\n";
+}
+
+static void std_hash_map_lookup([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<size_t, size_t> table;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        table.emplace(i * 7u, i);
+
+    lap("insert", start);
+    size_t hits = 0u;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u) != table.end()) ++hits;
+
+    lap("hit", start);
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u + 1u) != table.end()) ++hits;
+
+    lap("miss", start);
+    std::cout << hits << " hits\n";
+}
+
+static void test_flat_map_with_strings([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::flat_map<std::string, int> ages = { { "dog", 5 }, { "cat", 3 } };
+
+    ages.insert("fish", 1);
+    ages["owl"] = 7;
+
+    aggro::map_entry<std::string, int> more[] = { { "ant", 2 }, { "cat", 10 }, { "bee", 4 }, { "ant", 9 } };
+    ages.insert_range(more, more + 4);
+
+    auto dog = ages.find("dog");
+    auto cow = ages.find("cow");
+
+    if(dog && !cow)
+        *dog = 6;
+
+    ages.erase("fish");
+
+    for(auto entry : ages)
+        std::cout << entry.first << " " << entry.second << "\n";
+
+    aggro::flat_set<int> primes = { 7, 2, 5, 3 };
+    int more_primes[] = { 13, 2, 11, 7 };
+
+    primes.insert_range(more_primes, more_primes + 4);
+    primes.erase(5);
+
+    for(int p : primes)
+        std::cout << p << " ";
+
+    std::cout << "\n";
+}
+
+//Sums every value through a const map so only the const find/begin/end overloads are used.
+static int sum_flat_map(const aggro::flat_map<std::string, int>& map)
+{
+    int sum = 0;
+
+    for(auto entry : map)
+        sum += entry.second;
+
+    if(auto cat = map.find("cat"))
+        sum += *cat;
+
+    return sum;
+}
+
+static void test_flat_map_const([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    const aggro::flat_map<std::string, int> ages = { { "dog", 5 }, { "cat", 3 }, { "owl", 7 } };
+
+    std::cout << sum_flat_map(ages) << " " << ages.contains("owl") << " " << static_cast<bool>(ages.find("cow")) << "\n";
+}
+
+static void test_flat_map_bulk_lookup([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    auto start = std::chrono::steady_clock::now();
+    aggro::darray<aggro::map_entry<size_t, size_t>> entries(key_count);
+
+    for(size_t i = 0u; i < key_count; ++i)
+        entries.emplace_back((i * 7919u) % key_count * 7u, i);
+
+    aggro::flat_map<size_t, size_t> table;
+    table.insert_range(entries.begin(), entries.end());
+
+    lap("insert", start);
+    size_t hits = 0u;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u)) ++hits;
+
+    lap("hit", start);
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u + 1u)) ++hits;
+
+    lap("miss", start);
+    std::cout << hits << " hits\n";
+}
+
+static void std_flat_map_bulk_lookup([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::map<size_t, size_t> table;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        table.emplace((i * 7919u) % key_count * 7u, i);
+
+    lap("insert", start);
+    size_t hits = 0u;
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u) != table.end()) ++hits;
+
+    lap("hit", start);
+
+    for(size_t i = 0u; i < key_count; ++i)
+        if(table.find(i * 7u + 1u) != table.end()) ++hits;
+
+    lap("miss", start);
+    std::cout << hits << " hits\n";
+}
+
+static void test_slot_map([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::slot_map<std::string> names;
+
+    auto cat = names.insert("cat");
+    auto dog = names.insert("dog");
+    auto owl = names.emplace("owl");
+
+    names.erase(cat);
+
+    if(!names.find(cat) && !names.erase(cat))
+        std::cout << "cat handle is stale\n";
+
+    auto ant = names.insert("ant");
+
+    if(ant.index == cat.index && ant != cat && !names.contains(cat))
+        std::cout << "ant reuses cat's slot\n";
+
+    if(auto found = names.find(owl))
+        *found += "!";
+
+    for(size_t i = 0u; i < names.size(); ++i)
+        std::cout << names.begin()[i] << (names.handle_at(i) == dog ? " (dog)" : "") << "\n";
+
+    names.clear();
+    std::cout << names.size() << " left, dog " << (names.contains(dog) ? "alive" : "gone") << "\n";
+}
+
+static void test_sparse_set([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::sparse_set<float> positions;
+    aggro::sparse_set<std::string> names;
+
+    for(uint32_t id : { 9u, 2u, 5u, 7u })
+        positions.emplace(id, static_cast<float>(id) * 10.0f);
+
+    names.insert(5u, "five");
+    names.insert(4u, "four");
+    names.insert(9u, "nine");
+
+    positions.erase(7u);
+
+    if(!positions.contains(7u) && !positions.erase(7u) && !names.find(2u))
+        std::cout << "7 and 2 are missing where expected\n";
+
+    positions.sort_as(names);
+
+    //The shared ids now come first in both sets, in the same order.
+    for(size_t i = 0u; i < positions.size() && names.contains(positions.entities()[i]); ++i)
+        std::cout << positions.entities()[i] << " " << positions.begin()[i] << " " << *names.find(positions.entities()[i]) << "\n";
+}
+
+static void test_sparse_set_reserve([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::sparse_set<std::string> names;
+
+    for(uint32_t id = 0u; id < 100u; ++id)
+        names.emplace(id, "entity number " + std::to_string(id));
+
+    //Reserving less than is already held must leave the values alone.
+    names.reserve(4u);
+    names.reserve(200u);
+
+    std::cout << names.size() << " names, id 42: " << *names.find(42u) << ", id 99: " << *names.find(99u) << "\n";
+}
+
+int main()
+{
+    MEM_CHECK(test_hash_map_with_strings)
+    MEM_CHECK(test_hash_map_lookup)
+    MEM_CHECK(std_hash_map_lookup)
+    MEM_CHECK(test_flat_map_with_strings)
+    MEM_CHECK(test_flat_map_const)
+    MEM_CHECK(test_flat_map_bulk_lookup)
+    MEM_CHECK(std_flat_map_bulk_lookup)
+    MEM_CHECK(test_slot_map)
+    MEM_CHECK(test_sparse_set)
+    MEM_CHECK(test_sparse_set_reserve)
+}
@@ -0,0 +1,421 @@
+#define AGGRO_MEMORY_PROFILE
+#include "profile.hpp"
+#include "queue.hpp"
+#include "priority_queue.hpp"
+#include "job.hpp"
+#include "parallel.hpp"
+#include "array.hpp"
+#include <string>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+
+static constexpr size_t message_count = 1000000u;
+
+static void test_spsc_ring([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::spsc_ring<int, 4> ring;
+
+    for(int i = 0; i < 6; ++i)
+    {
+        if(!ring.try_push(i))
+            std::cout << "ring full at " << i << "\n";
+    }
+
+    while(auto value = ring.try_pop())
+        std::cout << *value << " ";
+
+    std::cout << "\n";
+}
+
+static void test_spsc_throughput([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    static aggro::spsc_ring<size_t, 1024> ring;
+    size_t sum = 0u;
+
+    std::thread consumer([&sum]() {
+        size_t received = 0u;
+
+        while(received < message_count)
+        {
+            if(auto value = ring.try_pop())
+            {
+                sum += *value;
+                ++received;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for(size_t i = 0u; i < message_count; ++i)
+    {
+        while(!ring.try_push(i)) std::this_thread::yield();
+    }
+
+    consumer.join();
+
+    std::cout << "sum " << sum << "\n";
+}
+
+static void std_mutex_deque_throughput([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    std::deque<size_t> queue;
+    std::mutex lock;
+    size_t sum = 0u;
+
+    std::thread consumer([&]() {
+        size_t received = 0u;
+
+        while(received < message_count)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+
+                if(!queue.empty())
+                {
+                    sum += queue.front();
+                    queue.pop_front();
+                    ++received;
+                    continue;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    });
+
+    for(size_t i = 0u; i < message_count; ++i)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.push_back(i);
+    }
+
+    consumer.join();
+
+    std::cout << "sum " << sum << "\n";
+}
+
+static void test_mpmc_queue([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::mpmc_queue<std::string> queue(4);
+    std::string words[] = { "one", "two", "three", "four", "five" };
+
+    std::cout << queue.push_n(words, 5) << " of 5 pushed, capacity " << queue.capacity() << "\n";
+
+    auto first = queue.try_pop();
+    std::string rest[3];
+
+    std::cout << *first << " then " << queue.pop_n(rest, 3) << " more: " << rest[0] << " " << rest[1] << " " << rest[2] << "\n";
+    std::cout << "empty " << (queue.try_pop().has_value() ? "no" : "yes") << "\n";
+}
+
+//Splits 'threads' into producers and consumers and moves message_count values through the queue.
+static void mpmc_scaling(size_t threads, size_t batch)
+{
+    aggro::mpmc_queue<size_t> queue(1024);
+    const size_t producers = (threads > 1u) ? threads / 2u : 1u;
+    const size_t consumers = (threads > 1u) ? threads - producers : 1u;
+    const size_t per_producer = message_count / producers;
+
+    std::atomic<size_t> received { 0u };
+    std::atomic<size_t> sum { 0u };
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(size_t p = 0u; p < producers; ++p)
+    {
+        workers.emplace_back([&, p]() {
+            size_t values[64];
+            size_t next = p * per_producer;
+            const size_t stop = next + per_producer;
+
+            while(next < stop)
+            {
+                size_t count = (stop - next < batch) ? stop - next : batch;
+
+                for(size_t i = 0u; i < count; ++i)
+                    values[i] = next + i;
+
+                size_t pushed = 0u;
+
+                while(pushed < count)
+                {
+                    size_t done = queue.push_n(values + pushed, count - pushed);
+                    if(done == 0u) std::this_thread::yield();
+                    pushed += done;
+                }
+
+                next += count;
+            }
+        });
+    }
+
+    for(size_t c = 0u; c < consumers; ++c)
+    {
+        workers.emplace_back([&]() {
+            size_t values[64];
+            size_t local = 0u;
+
+            while(received.load(std::memory_order_relaxed) < per_producer * producers)
+            {
+                size_t got = queue.pop_n(values, batch);
+
+                if(got == 0u)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                for(size_t i = 0u; i < got; ++i)
+                    local += values[i];
+
+                received.fetch_add(got, std::memory_order_relaxed);
+            }
+
+            sum.fetch_add(local);
+        });
+    }
+
+    for(auto& worker : workers)
+        worker.join();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << producers << " producers, " << consumers << " consumers, batch " << batch << ": " << elapsed.count() << " microseconds, sum " << sum.load() << "\n";
+}
+
+static void test_mpmc_scaling([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    for(size_t threads = 1u; threads <= 16u; threads *= 2u)
+    {
+        mpmc_scaling(threads, 1u);
+        mpmc_scaling(threads, 32u);
+    }
+}
+
+static void test_priority_queue([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::priority_queue<int> numbers;
+    int batch[] = { 5, 1, 9, 3, 7, 2, 8 };
+
+    numbers.push_range(batch, batch + 7);
+    numbers.push(6);
+    numbers.emplace(4);
+
+    if(auto top = numbers.top())
+        std::cout << "top " << *top << "\n";
+
+    while(auto next = numbers.pop())
+        std::cout << *next << " ";
+
+    std::cout << "\n";
+
+    struct event
+    {
+        size_t time = 0u;
+        std::string name;
+    };
+
+    auto later = [](const event& a, const event& b) { return a.time > b.time; };
+    aggro::priority_queue<event, decltype(later), 2u> events(later);
+
+    events.push(event{ 30u, "save" });
+    events.push(event{ 10u, "spawn" });
+    events.push(event{ 20u, "attack" });
+
+    while(auto next = events.pop())
+        std::cout << next->time << " " << next->name << "\n";
+
+    if(!events.pop())
+        std::cout << "no more events\n";
+}
+
+static void test_heap_counter_threads([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    constexpr size_t threads = 4u;
+    constexpr size_t blocks = 10000u;
+
+    const aggro::heap_stats before = aggro::heap_counter::totals();
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for(size_t i = 0u; i < threads; ++i)
+    {
+        workers.emplace_back([] {
+            for(size_t j = 0u; j < blocks; ++j)
+            {
+                int* block = new int[j % 64u + 1u];
+                delete[] block;
+            }
+
+            struct alignas(64) line { char bytes[64]; };
+            delete new line;
+
+            aggro::heap_stats mine = aggro::heap_counter::thread_totals();
+
+            if(mine.allocations != blocks + 1u || mine.live != 0)
+                std::cout << "thread counters are off\n";
+        });
+    }
+
+    for(auto& worker : workers)
+        worker.join();
+
+    const aggro::heap_stats after = aggro::heap_counter::totals();
+    std::cout << after.allocations - before.allocations << " allocations from " << threads << " threads\n";
+
+    for(size_t i = 0u; i < aggro::heap_size_classes; ++i)
+        if(after.histogram[i] != before.histogram[i])
+            std::cout << "  up to " << (8u << i) << " bytes: " << after.histogram[i] - before.histogram[i] << "\n";
+}
+
+//Sums [first, last) by splitting it into child jobs until the pieces are small.
+static void sum_range(aggro::job_system& jobs, const size_t* first, const size_t* last, std::atomic<size_t>& total)
+{
+    if(last - first <= 1024)
+    {
+        size_t sum = 0u;
+
+        for(; first != last; ++first)
+            sum += *first;
+
+        total.fetch_add(sum, std::memory_order_relaxed);
+        return;
+    }
+
+    const size_t* middle = first + (last - first) / 2;
+    aggro::job* parent = aggro::job_system::current_job();
+
+    jobs.submit([&jobs, first, middle, &total] { sum_range(jobs, first, middle, total); }, parent);
+    jobs.submit([&jobs, middle, last, &total] { sum_range(jobs, middle, last, total); }, parent);
+}
+
+static void test_job_system([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::job_system jobs(3u);
+    std::vector<size_t> values(1u << 20u);
+
+    for(size_t i = 0u; i < values.size(); ++i)
+        values[i] = i;
+
+    const aggro::heap_stats before = aggro::heap_counter::totals();
+
+    //Flat jobs counted on one counter.
+    std::atomic<size_t> hits { 0u };
+    aggro::job_counter flat;
+
+    for(size_t i = 0u; i < 10000u; ++i)
+        jobs.submit([&hits] { hits.fetch_add(1u, std::memory_order_relaxed); }, flat);
+
+    jobs.wait(flat);
+
+    //One root job whose children split the array. The counter only drops once every child is done.
+    std::atomic<size_t> total { 0u };
+    aggro::job_counter tree;
+
+    jobs.submit([&] { sum_range(jobs, values.data(), values.data() + values.size(), total); }, tree);
+    jobs.wait(tree);
+
+    const aggro::heap_stats after = aggro::heap_counter::totals();
+
+    std::cout << jobs.worker_count() << " workers, " << hits.load() << " flat jobs, tree sum " << total.load()
+        << ", " << after.allocations - before.allocations << " allocations while submitting\n";
+}
+
+static void test_job_system_full_ring([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::job_system jobs(2u);
+    std::vector<size_t> values(1u << 16u);
+
+    for(size_t i = 0u; i < values.size(); ++i)
+        values[i] = i;
+
+    //Fill the calling worker's ring with jobs that cannot finish yet, so the next submit has to run inline.
+    std::atomic<bool> release { false };
+    aggro::job_counter fillers;
+
+    for(size_t i = 0u; i < aggro::job_system::jobs_per_worker; ++i)
+    {
+        jobs.submit([&release]
+        {
+            while(!release.load(std::memory_order_acquire))
+                std::this_thread::yield();
+        }, fillers);
+    }
+
+    //The root runs inline. Once the ring drains its children are queued, and the counter must still cover them.
+    std::atomic<size_t> total { 0u };
+    aggro::job_counter tree;
+
+    aggro::job* root = jobs.submit([&]
+    {
+        release.store(true, std::memory_order_release);
+        jobs.wait(fillers);
+        sum_range(jobs, values.data(), values.data() + values.size(), total);
+    }, tree);
+
+    jobs.wait(tree);
+
+    const size_t expected = values.size() * (values.size() - 1u) / 2u;
+
+    std::cout << "root ran inline: " << (root == nullptr) << ", tree sum " << total.load()
+        << (total.load() == expected ? " (complete)" : " (incomplete)") << "\n";
+}
+
+static void test_parallel_algorithms([[maybe_unused]] aggro::bench_timer t, [[maybe_unused]] aggro::heap_counter h)
+{
+    aggro::job_system jobs(3u);
+    aggro::darray<int> values;
+    aggro::darray<long long> scanned;
+    values.reserve(1000003u);
+    scanned.reserve(values.capacity());
+
+    for(size_t i = 0u; i < values.capacity(); ++i)
+    {
+        values.push_back(static_cast<int>(i % 7u));
+        scanned.push_back(0);
+    }
+
+    //Offset by one element so the chunks have to line up with cache lines on their own.
+    aggro::parallel_for_each(jobs, values.data() + 1, values.data() + values.size(), [](int& v) { v *= 3; });
+    aggro::parallel_transform(jobs, values, scanned, [](int v) { return static_cast<long long>(v); });
+
+    const long long total = aggro::parallel_reduce(jobs, scanned, 0ll);
+    aggro::parallel_inclusive_scan(jobs, scanned, scanned);
+
+    //Concatenation is associative but not commutative, so this checks the chunks are combined in order.
+    aggro::array<std::string, 3> words = { "a", "b", "c" };
+    std::string joined = aggro::parallel_reduce(jobs, words.data(), words.data() + words.size(), std::string(">"),
+        std::plus<std::string>{}, aggro::parallel_options{ 1u, 0u });
+
+    long long expected = 0;
+
+    for(size_t i = 1u; i < values.size(); ++i)
+        expected += static_cast<long long>(i % 7u) * 3;
+
+    std::cout << "sum " << total << (total == expected ? " ok" : " wrong") << ", last prefix " << scanned[scanned.size() - 1u]
+        << ", prefix 10 " << scanned[10] << ", joined " << joined << "\n";
+
+    aggro::array<int, 8> small = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    aggro::parallel_inclusive_scan(jobs, small, small);
+    std::cout << "small scan ends at " << small[7] << "\n";
+}
+
+int main()
+{
+    MEM_CHECK(test_spsc_ring)
+    MEM_CHECK(test_spsc_throughput)
+    MEM_CHECK(std_mutex_deque_throughput)
+    MEM_CHECK(test_mpmc_queue)
+    MEM_CHECK(test_mpmc_scaling)
+    MEM_CHECK(test_priority_queue)
+    MEM_CHECK(test_heap_counter_threads)
+    MEM_CHECK(test_job_system)
+    MEM_CHECK(test_job_system_full_ring)
+    MEM_CHECK(test_parallel_algorithms)
+}